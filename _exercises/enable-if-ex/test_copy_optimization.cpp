@@ -1,18 +1,116 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define COPY_NON_TEMPORAL_SSE2
+#include <immintrin.h>
+#endif
+
 namespace Exercise
 {
     enum class Implementation {
         Generic,
-        Optimized
+        Optimized,
+        Parallel
+    };
+
+    // ParallelPolicy - copies contiguous ranges in chunks on worker threads
+    struct ParallelPolicy
+    {
+        size_t chunk_size = 1024 * 1024; // bytes - fits in L2 cache of a core
+        unsigned max_threads = 0;         // 0 - std::thread::hardware_concurrency()
+    };
+
+    inline constexpr ParallelPolicy par{};
+
+    namespace Detail
+    {
+        // copies above this size would only evict the working set from cache
+        inline constexpr size_t non_temporal_threshold = 64 * 1024 * 1024;
+
+        // destination is written with streaming stores bypassing the cache - ranges must not overlap
+        inline void copy_non_temporal(void* dest, const void* src, size_t bytes) noexcept
+        {
+#ifdef COPY_NON_TEMPORAL_SSE2
+            auto* d = static_cast<std::byte*>(dest);
+            auto* s = static_cast<const std::byte*>(src);
+
+            // streaming stores require 16-byte aligned destination
+            const size_t head = std::min(bytes, (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16);
+            std::memcpy(d, s, head);
+            d += head;
+            s += head;
+            bytes -= head;
+
+            for (; bytes >= 64; bytes -= 64, d += 64, s += 64)
+            {
+                const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+                const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+                const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+                const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+            }
+
+            std::memcpy(d, s, bytes);
+            _mm_sfence(); // streaming stores are weakly ordered
+#else
+            std::memcpy(dest, src, bytes);
+#endif
+        }
+
+        inline void copy_bytes(void* dest, const void* src, size_t bytes) noexcept
+        {
+            const auto d = reinterpret_cast<std::uintptr_t>(dest);
+            const auto s = reinterpret_cast<std::uintptr_t>(src);
+            const bool overlap = d < s + bytes && s < d + bytes;
+
+            if (bytes >= non_temporal_threshold && !overlap)
+                copy_non_temporal(dest, src, bytes);
+            else
+                std::memmove(dest, src, bytes);
+        }
+    } // namespace Detail
+
+    // items may be copied with memmove - contiguous ranges of the same trivially copyable type
+    template <typename InputIterator, typename OutputIterator, typename = void>
+    struct is_memmove_copyable : std::false_type
+    {
+    };
+
+    template <typename InputIterator, typename OutputIterator>
+    struct is_memmove_copyable<InputIterator, OutputIterator,
+        std::enable_if_t<std::contiguous_iterator<InputIterator> && std::contiguous_iterator<OutputIterator>>>
+        : std::bool_constant<
+              std::is_same_v<std::iter_value_t<InputIterator>, std::iter_value_t<OutputIterator>>
+              && std::is_same_v<std::iter_reference_t<OutputIterator>, std::iter_value_t<OutputIterator>&>
+              && std::is_trivially_copyable_v<std::iter_value_t<OutputIterator>>
+              && std::is_trivially_copy_assignable_v<std::iter_value_t<OutputIterator>>>
+    {
     };
 
     template <typename InputIterator, typename OutputIterator>
-    Implementation copy(InputIterator start, InputIterator end, OutputIterator dest)
+    constexpr bool is_memmove_copyable_v = is_memmove_copyable<InputIterator, OutputIterator>::value;
+
+    template <typename InputIterator, typename OutputIterator>
+    std::enable_if_t<!is_memmove_copyable_v<InputIterator, OutputIterator>, Implementation>
+    copy(InputIterator start, InputIterator end, OutputIterator dest)
     {
         for (auto it = start; it != end; ++it, ++dest)
         {
@@ -21,9 +119,89 @@ namespace Exercise
 
         return Implementation::Generic;
     }
-} // namespace Exercise
 
-// TODO - optimized version with memcpy of copy
+    template <typename InputIterator, typename OutputIterator>
+    std::enable_if_t<is_memmove_copyable_v<InputIterator, OutputIterator>, Implementation>
+    copy(InputIterator start, InputIterator end, OutputIterator dest)
+    {
+        using T = std::iter_value_t<OutputIterator>;
+
+        if (const auto count = end - start; count > 0)
+            Detail::copy_bytes(std::to_address(dest), std::to_address(start), count * sizeof(T));
+
+        return Implementation::Optimized;
+    }
+
+    namespace Detail
+    {
+        // below this size starting threads costs more than the copy
+        inline constexpr size_t parallel_threshold = 16 * 1024 * 1024;
+
+        // ranges must not overlap
+        inline void copy_bytes_parallel(const ParallelPolicy& policy, void* dest, const void* src, size_t bytes)
+        {
+            const size_t chunk_size = std::max<size_t>(policy.chunk_size, 4096);
+            const size_t chunk_count = (bytes + chunk_size - 1) / chunk_size;
+            const bool non_temporal = bytes >= non_temporal_threshold;
+
+            std::atomic<size_t> next_chunk{0};
+
+            auto worker = [&] {
+                for (size_t i = next_chunk++; i < chunk_count; i = next_chunk++)
+                {
+                    const size_t offset = i * chunk_size;
+                    const size_t length = std::min(chunk_size, bytes - offset);
+
+                    if (non_temporal)
+                        copy_non_temporal(static_cast<std::byte*>(dest) + offset, static_cast<const std::byte*>(src) + offset, length);
+                    else
+                        std::memcpy(static_cast<std::byte*>(dest) + offset, static_cast<const std::byte*>(src) + offset, length);
+                }
+            };
+
+            const unsigned hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+            const size_t thread_count = std::min<size_t>(policy.max_threads ? policy.max_threads : hardware_threads, chunk_count);
+
+            std::vector<std::jthread> helpers;
+            helpers.reserve(thread_count - 1);
+
+            for (size_t i = 1; i < thread_count; ++i)
+                helpers.emplace_back(worker);
+
+            worker(); // calling thread copies too
+        }
+    } // namespace Detail
+
+    template <typename InputIterator, typename OutputIterator>
+    Implementation copy(const ParallelPolicy& policy, InputIterator start, InputIterator end, OutputIterator dest)
+    {
+        if constexpr (is_memmove_copyable_v<InputIterator, OutputIterator>)
+        {
+            using T = std::iter_value_t<OutputIterator>;
+
+            const auto count = end - start;
+            const size_t bytes = count > 0 ? count * sizeof(T) : 0;
+
+            void* d = std::to_address(dest);
+            const void* s = std::to_address(start);
+
+            const auto d_addr = reinterpret_cast<std::uintptr_t>(d);
+            const auto s_addr = reinterpret_cast<std::uintptr_t>(s);
+            const bool overlap = d_addr < s_addr + bytes && s_addr < d_addr + bytes;
+
+            if (bytes < Detail::parallel_threshold || overlap)
+                return Exercise::copy(start, end, dest);
+
+            Detail::copy_bytes_parallel(policy, d, s, bytes);
+
+            return Implementation::Parallel;
+        }
+        else
+        {
+            return Exercise::copy(start, end, dest);
+        }
+    }
+} // namespace Exercise
 
 TEST_CASE("copy algorithm")
 {
@@ -48,12 +226,124 @@ TEST_CASE("copy algorithm")
         REQUIRE(std::equal(begin(words), end(words), begin(dest), end(dest)));
     }
 
-    // SECTION("optimized for arrays of POD types")
-    // {
-    //     int tab1[5] = {1, 2, 3, 4, 5};
-    //     int tab2[5];
+    SECTION("optimized for arrays of POD types")
+    {
+        int tab1[5] = {1, 2, 3, 4, 5};
+        int tab2[5];
+
+        REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
+        REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
+    }
+
+    SECTION("optimized for contiguous containers of POD types")
+    {
+        struct Point
+        {
+            int x, y;
+        };
+
+        const std::vector<Point> points = {{1, 2}, {3, 4}, {5, 6}};
+        std::array<Point, 3> dest{};
+
+        REQUIRE(Exercise::copy(points.begin(), points.end(), dest.begin()) == Implementation::Optimized);
+        REQUIRE(dest[2].x == 5);
+        REQUIRE(dest[2].y == 6);
+    }
+
+    SECTION("overlapping ranges - like std::copy, destination may start before source")
+    {
+        std::vector<int> vec = {1, 2, 3, 4, 5};
+
+        REQUIRE(Exercise::copy(vec.begin() + 1, vec.end(), vec.begin()) == Implementation::Optimized);
+        REQUIRE(vec == std::vector<int>{2, 3, 4, 5, 5});
+    }
+
+    SECTION("generic for different value types")
+    {
+        const int tab[3] = {1, 2, 3};
+        long dest[3];
+
+        REQUIRE(Exercise::copy(begin(tab), end(tab), begin(dest)) == Implementation::Generic);
+        REQUIRE(dest[2] == 3);
+    }
+}
+
+TEST_CASE("parallel copy")
+{
+    using Exercise::Implementation;
 
-    //     REQUIRE(Exercise::copy(begin(tab1), end(tab1), begin(tab2)) == Implementation::Optimized);
-    //     REQUIRE(std::equal(begin(tab1), end(tab1), begin(tab2), end(tab2)));
-    // }
+    SECTION("large contiguous ranges are copied in chunks on many threads")
+    {
+        std::vector<int> src(Exercise::Detail::parallel_threshold / sizeof(int) + 12345);
+        std::iota(src.begin(), src.end(), 0);
+        std::vector<int> dest(src.size());
+
+        const Exercise::ParallelPolicy policy{.chunk_size = 64 * 1024, .max_threads = 4};
+
+        REQUIRE(Exercise::copy(policy, src.begin(), src.end(), dest.begin()) == Implementation::Parallel);
+        REQUIRE(src == dest);
+    }
+
+    SECTION("small contiguous ranges are copied by the calling thread")
+    {
+        int tab1[5] = {1, 2, 3, 4, 5};
+        int tab2[5];
+
+        REQUIRE(Exercise::copy(Exercise::par, std::begin(tab1), std::end(tab1), std::begin(tab2)) == Implementation::Optimized);
+        REQUIRE(std::equal(std::begin(tab1), std::end(tab1), std::begin(tab2), std::end(tab2)));
+    }
+
+    SECTION("non-contiguous ranges use generic loop")
+    {
+        const std::list<int> lst = {1, 2, 3};
+        std::vector<int> vec(3);
+
+        REQUIRE(Exercise::copy(Exercise::par, lst.begin(), lst.end(), vec.begin()) == Implementation::Generic);
+        REQUIRE(vec == std::vector<int>{1, 2, 3});
+    }
+}
+
+TEST_CASE("copy with non-temporal stores")
+{
+    std::vector<unsigned char> src(1000);
+    std::iota(src.begin(), src.end(), 0);
+
+    for (size_t offset : {0, 1, 7, 15})
+    {
+        std::vector<unsigned char> dest(src.size() + offset);
+        Exercise::Detail::copy_non_temporal(dest.data() + offset, src.data(), src.size() - offset);
+
+        REQUIRE(std::equal(src.begin(), src.end() - offset, dest.begin() + offset));
+    }
+}
+
+TEST_CASE("copy of large buffers - benchmark", "[.][benchmark]")
+{
+    constexpr size_t size = 2 * Exercise::Detail::non_temporal_threshold;
+
+    const auto src = std::make_unique_for_overwrite<std::byte[]>(size);
+    const auto dest = std::make_unique_for_overwrite<std::byte[]>(size);
+    std::memset(src.get(), 1, size);
+    std::memset(dest.get(), 0, size);
+
+    BENCHMARK("memmove")
+    {
+        std::memmove(dest.get(), src.get(), size);
+        return dest[size - 1];
+    };
+
+    BENCHMARK("non-temporal stores")
+    {
+        Exercise::Detail::copy_non_temporal(dest.get(), src.get(), size);
+        return dest[size - 1];
+    };
+
+    for (unsigned threads : {1u, 2u, 4u, std::max(std::thread::hardware_concurrency(), 1u)})
+    {
+        BENCHMARK("parallel - threads: " + std::to_string(threads))
+        {
+            Exercise::Detail::copy_bytes_parallel(Exercise::ParallelPolicy{.max_threads = threads}, dest.get(), src.get(), size);
+            return dest[size - 1];
+        };
+    }
 }
\ No newline at end of file
@@ -1,70 +1,173 @@
 #ifndef PARAGRAPH_HPP_
 #define PARAGRAPH_HPP_
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
-#include <vector>
 #include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "render_sink.hpp"
+#include "work_stealing_pool.hpp"
 
 namespace LegacyCode
 {
-    // TODO - implement move semantics for Paragraph
+    // Short texts are stored inline (no heap allocation), longer ones in an exact-sized heap block
     class Paragraph
     {
-        char* buffer_;
+    public:
+        static constexpr size_t inline_capacity = 15;
+
+    private:
+        char* buffer_; // inline_buffer_, heap block or nullptr in moved-from state
+        size_t length_;
+        char inline_buffer_[inline_capacity + 1];
+
+        bool is_inline() const noexcept
+        {
+            return buffer_ == inline_buffer_;
+        }
+
+        // only for construction - previous buffer is not released
+        void assign(std::string_view txt)
+        {
+            buffer_ = (txt.size() <= inline_capacity) ? inline_buffer_ : new char[txt.size() + 1];
+            length_ = txt.copy(buffer_, txt.size());
+            buffer_[length_] = '\0';
+        }
+
+        // only for construction - previous buffer is not released
+        void steal(Paragraph& p) noexcept
+        {
+            if (p.is_inline())
+            {
+                std::memcpy(inline_buffer_, p.inline_buffer_, p.length_ + 1);
+                buffer_ = inline_buffer_;
+            }
+            else
+            {
+                buffer_ = p.buffer_;
+            }
+
+            length_ = std::exchange(p.length_, 0);
+            p.buffer_ = nullptr;
+        }
+
+        void release() noexcept
+        {
+            if (!is_inline())
+                delete[] buffer_;
+        }
 
     protected:
-        void swap(Paragraph& p)
+        void swap(Paragraph& p) noexcept
         {
-            std::swap(buffer_, p.buffer_);
+            Paragraph temp(std::move(p));
+            p = std::move(*this);
+            *this = std::move(temp);
         }
 
     public:
         Paragraph()
-            : buffer_(new char[1024])
+            : Paragraph("Default text!")
         {
-            std::strcpy(buffer_, "Default text!");
         }
 
-        Paragraph(const Paragraph& p)
-            : buffer_(new char[1024])
+        Paragraph(std::string_view txt)
         {
-            std::strcpy(buffer_, p.buffer_);
+            assign(txt);
         }
 
         Paragraph(const char* txt)
-            : buffer_(new char[1024])
+            : Paragraph(std::string_view{txt})
+        {
+        }
+
+        Paragraph(const Paragraph& p)
+            : Paragraph(p.text())
         {
-            std::strcpy(buffer_, txt);
         }
 
         Paragraph& operator=(const Paragraph& p)
         {
-            Paragraph temp(p);
-            swap(temp);
+            if (this != &p)
+            {
+                Paragraph temp(p);
+                release();
+                steal(temp);
+            }
+
+            return *this;
+        }
+
+        Paragraph(Paragraph&& p) noexcept
+        {
+            steal(p);
+        }
+
+        Paragraph& operator=(Paragraph&& p) noexcept
+        {
+            if (this != &p)
+            {
+                release();
+                steal(p);
+            }
 
             return *this;
         }
 
-        void set_paragraph(const char* txt)
+        void set_paragraph(std::string_view txt)
         {
-            std::strcpy(buffer_, txt);
+            *this = Paragraph(txt);
         }
 
-        const char* get_paragraph() const
+        const char* get_paragraph() const noexcept
         {
             return buffer_;
         }
 
+        std::string_view text() const noexcept
+        {
+            return {buffer_, length_};
+        }
+
+        size_t length() const noexcept
+        {
+            return length_;
+        }
+
+        void render_at(int posx, int posy, RenderSink& sink) const
+        {
+            sink.write("Rendering text '");
+            sink.write(text());
+            sink.write("' at: [");
+            sink.write(posx);
+            sink.write(", ");
+            sink.write(posy);
+            sink.write("]\n");
+        }
+
         void render_at(int posx, int posy) const
         {
-            std::cout << "Rendering text '" << buffer_ << "' at: [" << posx << ", " << posy << "]" << std::endl;
+            StreamSink sink{std::cout, StreamSink::unlimited_block_size};
+            render_at(posx, posy, sink);
         }
 
         virtual ~Paragraph()
         {
-            delete[] buffer_;
+            release();
         }
     };
 }
@@ -73,53 +176,332 @@ class Shape
 {
 public:
     virtual ~Shape() = default;
-    virtual void draw() const = 0;
+    virtual void draw(RenderSink& sink) const = 0;
+
+    // output must be the same as from draw(sink) - groups render their subtrees in parallel
+    virtual void draw_parallel(RenderSink& sink, WorkStealingPool& pool) const
+    {
+        (void)pool;
+        draw(sink);
+    }
+
+    // whole frame is written to std::cout at once
+    void draw() const
+    {
+        StreamSink sink{std::cout, StreamSink::unlimited_block_size};
+        draw(sink);
+    }
 };
 
-// TODO - ensure that Text is copyable & moveable type
 class Text : public Shape
 {
     int x_, y_;
     LegacyCode::Paragraph p_;
 
 public:
-    Text(int x, int y, const std::string& text)
+    Text(int x, int y, std::string_view text)
         : x_{x}
         , y_{y}
-        , p_{text.c_str()}
+        , p_{text}
     {
     }
 
-    void draw() const override
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
     {
-        p_.render_at(x_, y_);
+        p_.render_at(x_, y_, sink);
     }
 
     std::string text() const
     {
-        const char* txt = p_.get_paragraph();
-        return (txt == nullptr) ? "" : txt;
+        return std::string{p_.text()};
     }
 
-    void set_text(const std::string& text)
+    std::string_view text_view() const noexcept
     {
-        p_.set_paragraph(text.c_str());
+        return p_.text();
+    }
+
+    void set_text(std::string_view text)
+    {
+        p_.set_paragraph(text);
     }
 };
 
 struct ShapeGroup : public Shape
 {
-    std::vector<std::unique_ptr<Shape>> shapes;
+    using allocator_type = std::pmr::polymorphic_allocator<std::unique_ptr<Shape>>;
+
+    std::pmr::vector<std::unique_ptr<Shape>> shapes;
 
     ShapeGroup() = default;
 
-    void draw() const override
+    // array of shape pointers is allocated from resource
+    explicit ShapeGroup(std::pmr::memory_resource* resource)
+        : shapes{resource}
+    {
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return shapes.get_allocator();
+    }
+
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
     {
         for (const auto& s : shapes)
-            s->draw();
+            s->draw(sink);
     }
 
-    // TODO - implement adding a shape to a shapes container
+    // consecutive runs of shapes are rendered by pool tasks into separate buffers,
+    // buffers are written to sink in the original order
+    void draw_parallel(RenderSink& sink, WorkStealingPool& pool) const override
+    {
+        const size_t tasks_per_worker = 4;
+        const size_t chunk_count = std::min(shapes.size(), pool.size() * tasks_per_worker);
+
+        // subtree is split only while some workers may be idle - otherwise it is cheaper to render it in place
+        if (chunk_count <= 1 || pool.pending_tasks() >= pool.size())
+        {
+            draw(sink);
+            return;
+        }
+
+        std::vector<MemorySink> chunks(chunk_count);
+
+        TaskGroup tasks{pool};
+        for (size_t i = 0; i < chunk_count; ++i)
+        {
+            tasks.run([this, &chunks, &pool, i, chunk_count] {
+                const size_t first = i * shapes.size() / chunk_count;
+                const size_t last = (i + 1) * shapes.size() / chunk_count;
+
+                for (size_t j = first; j < last; ++j)
+                    shapes[j]->draw_parallel(chunks[i], pool);
+            });
+        }
+        tasks.wait();
+
+        for (const auto& chunk : chunks)
+            sink.write(chunk.str());
+    }
+
+    void add(std::unique_ptr<Shape> shape)
+    {
+        shapes.push_back(std::move(shape));
+    }
+};
+
+struct ShapeId
+{
+    uint32_t type;  // position of shape type in the list of batched types
+    uint32_t index; // position in the array of that type
+
+    bool operator==(const ShapeId&) const = default;
+};
+
+// BatchShapeGroup - shapes of listed types are stored by value in per-type contiguous arrays
+//
+// draw() walks each array once with a non-virtual call. Other shapes can still be added
+// through the Shape interface - they are kept in a fallback vector<unique_ptr<Shape>>.
+// Shapes are drawn grouped by type (in the order of TShapes, fallback shapes last), not in
+// insertion order - output differs from ShapeGroup with the same shapes unless the order does not matter.
+template <typename... TShapes>
+class BatchShapeGroup : public Shape
+{
+    static_assert((std::is_base_of_v<Shape, TShapes> && ...), "batched types must derive from Shape");
+
+    std::tuple<std::vector<TShapes>...> pools_;
+    std::vector<std::unique_ptr<Shape>> others_;
+
+    // position of TShape in the list of batched types - sizeof...(TShapes) if it is not batched
+    template <typename TShape>
+    static constexpr size_t index_of_v = [] {
+        constexpr bool matches[] = {std::is_same_v<TShape, TShapes>...};
+        for (size_t i = 0; i < sizeof...(TShapes); ++i)
+            if (matches[i])
+                return i;
+        return sizeof...(TShapes);
+    }();
+
+public:
+    static constexpr uint32_t others_type = sizeof...(TShapes);
+
+    template <typename TShape>
+    static constexpr bool is_batched_v = index_of_v<TShape> < sizeof...(TShapes);
+
+    BatchShapeGroup() = default;
+
+    template <typename TShape>
+        requires is_batched_v<std::remove_cvref_t<TShape>>
+    ShapeId add(TShape&& shape)
+    {
+        using Type = std::remove_cvref_t<TShape>;
+
+        auto& pool = items<Type>();
+        pool.push_back(std::forward<TShape>(shape));
+
+        return ShapeId{static_cast<uint32_t>(index_of_v<Type>), static_cast<uint32_t>(pool.size() - 1)};
+    }
+
+    template <typename TShape, typename... TArgs>
+        requires is_batched_v<TShape>
+    ShapeId emplace(TArgs&&... args)
+    {
+        return add(TShape(std::forward<TArgs>(args)...));
+    }
+
+    // shapes of batched types are moved out of the pointer into their array
+    ShapeId add(std::unique_ptr<Shape> shape)
+    {
+        if (!shape)
+            throw std::invalid_argument("Cannot add null shape");
+
+        ShapeId id{others_type, 0};
+
+        const bool is_batched = ((typeid(*shape) == typeid(TShapes) && (id = add(std::move(static_cast<TShapes&>(*shape))), true)) || ...);
+
+        if (!is_batched)
+        {
+            others_.push_back(std::move(shape));
+            id.index = static_cast<uint32_t>(others_.size() - 1);
+        }
+
+        return id;
+    }
+
+    template <typename TShape>
+    std::vector<TShape>& items() noexcept
+    {
+        return std::get<std::vector<TShape>>(pools_);
+    }
+
+    template <typename TShape>
+    const std::vector<TShape>& items() const noexcept
+    {
+        return std::get<std::vector<TShape>>(pools_);
+    }
+
+    const std::vector<std::unique_ptr<Shape>>& others() const noexcept
+    {
+        return others_;
+    }
+
+    template <typename TShape>
+    TShape& get(ShapeId id)
+    {
+        assert((id.type == index_of_v<TShape>));
+        return items<TShape>()[id.index];
+    }
+
+    size_t size() const noexcept
+    {
+        return (items<TShapes>().size() + ... + others_.size());
+    }
+
+    // f is called for every shape - once per type with the concrete type known at compile time
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        (for_each_item(items<TShapes>(), f), ...);
+
+        for (const auto& shape : others_)
+            f(*shape);
+    }
+
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
+    {
+        for_each([&sink](const auto& shape) {
+            using Type = std::remove_cvref_t<decltype(shape)>;
+
+            if constexpr (std::is_same_v<Type, Shape>)
+                shape.draw(sink);
+            else
+                shape.Type::draw(sink); // qualified call - no virtual dispatch for batched types
+        });
+    }
+
+private:
+    template <typename TShape, typename F>
+    static void for_each_item(const std::vector<TShape>& pool, F& f)
+    {
+        for (const auto& shape : pool)
+            f(shape);
+    }
+};
+
+// VariantShapeGroup - closed set of shape types stored inline as std::variant values
+//
+// Shapes are kept in insertion order without per-shape heap allocation.
+// draw() dispatches with std::visit - no virtual calls.
+template <typename... TShapes>
+class VariantShapeGroup : public Shape
+{
+public:
+    using value_type = std::variant<TShapes...>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+    std::vector<value_type> shapes_;
+
+public:
+    VariantShapeGroup() = default;
+
+    template <typename TShape>
+        requires std::is_constructible_v<value_type, TShape&&>
+    void add(TShape&& shape)
+    {
+        shapes_.emplace_back(std::forward<TShape>(shape));
+    }
+
+    template <typename TShape, typename... TArgs>
+    TShape& emplace(TArgs&&... args)
+    {
+        return std::get<TShape>(shapes_.emplace_back(std::in_place_type<TShape>, std::forward<TArgs>(args)...));
+    }
+
+    void reserve(size_t capacity)
+    {
+        shapes_.reserve(capacity);
+    }
+
+    size_t size() const noexcept
+    {
+        return shapes_.size();
+    }
+
+    const value_type& operator[](size_t index) const
+    {
+        return shapes_[index];
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return shapes_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return shapes_.end();
+    }
+
+    using Shape::draw;
+
+    void draw(RenderSink& sink) const override
+    {
+        for (const auto& shape : shapes_)
+        {
+            std::visit([&sink](const auto& s) {
+                using Type = std::remove_cvref_t<decltype(s)>;
+                s.Type::draw(sink); // qualified call - no virtual dispatch
+            }, shape);
+        }
+    }
 };
 
 #endif /*PARAGRAPH_HPP_*/
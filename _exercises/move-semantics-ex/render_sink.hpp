@@ -0,0 +1,186 @@
+#ifndef RENDER_SINK_HPP_
+#define RENDER_SINK_HPP_
+
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// RenderSink - destination of rendered output
+class RenderSink
+{
+public:
+    virtual ~RenderSink() = default;
+
+    virtual void write(std::string_view data) = 0;
+
+    virtual void flush()
+    {
+    }
+
+    void write(int value)
+    {
+        char digits[std::numeric_limits<int>::digits10 + 2];
+        const auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), value);
+        write(std::string_view(digits, end - digits));
+    }
+};
+
+// NullSink - discards output (benchmarks)
+class NullSink : public RenderSink
+{
+public:
+    using RenderSink::write;
+
+    void write(std::string_view) override
+    {
+    }
+};
+
+// MemorySink - whole output is kept in memory
+class MemorySink : public RenderSink
+{
+    std::string output_;
+
+public:
+    using RenderSink::write;
+
+    void write(std::string_view data) override
+    {
+        output_.append(data);
+    }
+
+    std::string_view str() const noexcept
+    {
+        return output_;
+    }
+
+    void clear() noexcept
+    {
+        output_.clear();
+    }
+};
+
+// BufferedSink - output is collected and passed to write_block() in large blocks
+class BufferedSink : public RenderSink
+{
+    std::string buffer_;
+    size_t block_size_;
+
+protected:
+    explicit BufferedSink(size_t block_size)
+        : block_size_{block_size}
+    {
+        if (block_size_ != unlimited_block_size)
+            buffer_.reserve(block_size_);
+    }
+
+    virtual void write_block(std::string_view block) = 0;
+
+public:
+    static constexpr size_t default_block_size = 64 * 1024;
+    static constexpr size_t unlimited_block_size = std::numeric_limits<size_t>::max(); // single write on flush()
+
+    using RenderSink::write;
+
+    void write(std::string_view data) override
+    {
+        buffer_.append(data);
+
+        if (buffer_.size() >= block_size_)
+            flush();
+    }
+
+    void flush() override
+    {
+        if (!buffer_.empty())
+        {
+            write_block(buffer_);
+            buffer_.clear();
+        }
+    }
+};
+
+// StreamSink - blocks are written to std::ostream
+class StreamSink : public BufferedSink
+{
+    std::ostream& out_;
+
+public:
+    explicit StreamSink(std::ostream& out, size_t block_size = default_block_size)
+        : BufferedSink{block_size}
+        , out_{out}
+    {
+    }
+
+    StreamSink(const StreamSink&) = delete;
+    StreamSink& operator=(const StreamSink&) = delete;
+
+    ~StreamSink() override
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+protected:
+    void write_block(std::string_view block) override
+    {
+        out_.write(block.data(), static_cast<std::streamsize>(block.size()));
+        out_.flush();
+    }
+};
+
+// FileSink - blocks are written to a file
+class FileSink : public BufferedSink
+{
+    struct FileCloser
+    {
+        void operator()(std::FILE* file) const noexcept
+        {
+            std::fclose(file);
+        }
+    };
+
+    std::unique_ptr<std::FILE, FileCloser> file_;
+
+public:
+    explicit FileSink(const std::string& path, size_t block_size = default_block_size)
+        : BufferedSink{block_size}
+        , file_{std::fopen(path.c_str(), "wb")}
+    {
+        if (!file_)
+            throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    ~FileSink() override
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+protected:
+    void write_block(std::string_view block) override
+    {
+        if (std::fwrite(block.data(), 1, block.size(), file_.get()) != block.size())
+            throw std::runtime_error("Write to file failed");
+    }
+};
+
+#endif /*RENDER_SINK_HPP_*/
@@ -1,9 +1,23 @@
 
+#include "memory_resources.hpp"
 #include "paragraph.hpp"
 
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <variant>
+#include <vector>
 
 using namespace std;
 
@@ -16,6 +30,74 @@ TEST_CASE("Moving paragraph")
     REQUIRE(txt.get_paragraph() == nullptr);
 }
 
+TEST_CASE("Paragraph storage")
+{
+    using LegacyCode::Paragraph;
+
+    static_assert(std::is_nothrow_move_constructible_v<Paragraph>);
+    static_assert(std::is_nothrow_move_assignable_v<Paragraph>);
+    static_assert(sizeof(Paragraph) <= 48);
+
+    SECTION("short text is stored inline")
+    {
+        Paragraph p("***");
+        const auto* p_address = reinterpret_cast<const char*>(&p);
+
+        REQUIRE(p.text() == "***"sv);
+        REQUIRE(p.get_paragraph() >= p_address);
+        REQUIRE(p.get_paragraph() < p_address + sizeof(Paragraph));
+    }
+
+    SECTION("long text is stored on heap")
+    {
+        const std::string long_text(2048, 'x'); // more than the old 1024-byte buffer
+        Paragraph p(long_text);
+
+        REQUIRE(p.text() == long_text);
+        REQUIRE(p.length() == 2048);
+        REQUIRE(p.get_paragraph()[2048] == '\0');
+    }
+
+    SECTION("copy & assignment")
+    {
+        Paragraph short_p("short");
+        Paragraph long_p("a text that does not fit into inline buffer");
+
+        Paragraph copy = long_p;
+        REQUIRE(copy.text() == long_p.text());
+        REQUIRE(copy.get_paragraph() != long_p.get_paragraph());
+
+        copy = short_p;
+        REQUIRE(copy.text() == "short"sv);
+
+        short_p = std::move(long_p);
+        REQUIRE(short_p.text() == "a text that does not fit into inline buffer"sv);
+        REQUIRE(long_p.text().empty());
+    }
+
+    SECTION("moving inline text")
+    {
+        Paragraph p("inline");
+        Paragraph target = std::move(p);
+
+        REQUIRE(target.text() == "inline"sv);
+        REQUIRE(p.get_paragraph() == nullptr);
+    }
+
+    SECTION("set_paragraph")
+    {
+        Paragraph p;
+        REQUIRE(p.text() == "Default text!"sv);
+
+        p.set_paragraph("a text that does not fit into inline buffer");
+        REQUIRE(p.text() == "a text that does not fit into inline buffer"sv);
+
+        p.set_paragraph("");
+        REQUIRE(p.text().empty());
+        REQUIRE(p.get_paragraph() != nullptr);
+    }
+}
+
 TEST_CASE("Moving text shape")
 {
     Text txt{10, 20, "text"};
@@ -28,10 +110,453 @@ TEST_CASE("Moving text shape")
 TEST_CASE("ShapeGroup")
 {
     ShapeGroup sg;
-    // sg.add(std::make_unique<Text>(10, 20, "text")); // uncomment this line
+    sg.add(std::make_unique<Text>(10, 20, "text"));
 
     REQUIRE(sg.shapes.size() == 1);
 
     Text& t = dynamic_cast<Text&>(*sg.shapes[0]);
     REQUIRE(t.text() == "text"s);
-}
\ No newline at end of file
+}
+
+TEST_CASE("ShapeGroup & memory resources")
+{
+    Helpers::ArenaResource arena;
+
+    ShapeGroup sg{&arena};
+    for (int i = 0; i < 10; ++i)
+        sg.add(std::make_unique<Text>(i, i, "text"));
+
+    REQUIRE(sg.get_allocator().resource() == &arena);
+    REQUIRE(sg.shapes.size() == 10);
+    REQUIRE(arena.stats().bytes_used >= 10 * sizeof(std::unique_ptr<Shape>));
+
+    ShapeGroup target = std::move(sg);
+    REQUIRE(target.get_allocator().resource() == &arena);
+    REQUIRE(target.shapes.size() == 10);
+}
+
+namespace
+{
+    struct Circle : Shape
+    {
+        int x, y, r;
+
+        Circle(int x, int y, int r)
+            : x{x}
+            , y{y}
+            , r{r}
+        {
+        }
+
+        using Shape::draw;
+
+        void draw(RenderSink& sink) const override
+        {
+            sink.write("Drawing circle at: [");
+            sink.write(x);
+            sink.write(", ");
+            sink.write(y);
+            sink.write("] r: ");
+            sink.write(r);
+            sink.write("\n");
+        }
+    };
+
+    struct Line : Shape
+    {
+        using Shape::draw;
+
+        void draw(RenderSink& sink) const override
+        {
+            sink.write("Drawing line\n");
+        }
+    };
+} // namespace
+
+TEST_CASE("BatchShapeGroup")
+{
+    BatchShapeGroup<Text, Circle> sg;
+
+    SECTION("shapes of batched types are stored by value in per-type arrays")
+    {
+        ShapeId id1 = sg.add(Text{10, 20, "text"});
+        ShapeId id2 = sg.emplace<Circle>(1, 2, 3);
+        ShapeId id3 = sg.emplace<Text>(30, 40, "other text");
+
+        REQUIRE(sg.size() == 3);
+        REQUIRE(sg.items<Text>().size() == 2);
+        REQUIRE(sg.items<Circle>().size() == 1);
+
+        REQUIRE(id1 == ShapeId{0, 0});
+        REQUIRE(id2 == ShapeId{1, 0});
+        REQUIRE(sg.get<Text>(id3).text() == "other text"s);
+    }
+
+    SECTION("heterogeneous add - batched types are moved into their arrays")
+    {
+        sg.add(std::make_unique<Text>(10, 20, "text"));
+        ShapeId id = sg.add(std::make_unique<Line>());
+
+        REQUIRE(sg.items<Text>().size() == 1);
+        REQUIRE(sg.items<Text>()[0].text() == "text"s);
+        REQUIRE(id.type == sg.others_type);
+        REQUIRE(sg.others().size() == 1);
+    }
+
+    SECTION("null shape is rejected")
+    {
+        REQUIRE_THROWS_AS(sg.add(std::unique_ptr<Shape>{}), std::invalid_argument);
+        REQUIRE(sg.size() == 0);
+    }
+
+    SECTION("draw visits all shapes grouped by type")
+    {
+        sg.emplace<Text>(1, 1, "a");
+        sg.emplace<Circle>(2, 2, 2);
+        sg.emplace<Text>(3, 3, "b");
+        sg.add(std::make_unique<Line>());
+
+        std::vector<std::string> visited;
+        sg.for_each([&](const auto& shape) { visited.push_back(typeid(shape).name()); });
+
+        REQUIRE(visited == std::vector<std::string>{typeid(Text).name(), typeid(Text).name(), typeid(Circle).name(), typeid(Line).name()});
+
+        sg.draw();
+    }
+
+    SECTION("draw order is grouped by type, not insertion order")
+    {
+        sg.add(std::make_unique<Line>());
+        sg.emplace<Circle>(2, 2, 2);
+        sg.emplace<Text>(1, 1, "a");
+
+        MemorySink sink;
+        sg.draw(sink);
+
+        REQUIRE(sink.str() == "Rendering text 'a' at: [1, 1]\nDrawing circle at: [2, 2] r: 2\nDrawing line\n");
+    }
+}
+
+TEST_CASE("VariantShapeGroup")
+{
+    VariantShapeGroup<Text, Circle> sg;
+
+    sg.add(Text{10, 20, "text"});
+    sg.emplace<Circle>(1, 2, 3);
+    Text& txt = sg.emplace<Text>(30, 40, "other text");
+
+    REQUIRE(sg.size() == 3);
+    REQUIRE(txt.text() == "other text"s);
+
+    SECTION("insertion order is kept")
+    {
+        REQUIRE(std::holds_alternative<Text>(sg[0]));
+        REQUIRE(std::holds_alternative<Circle>(sg[1]));
+        REQUIRE(std::get<Text>(sg[2]).text() == "other text"s);
+    }
+
+    SECTION("can be nested in other groups")
+    {
+        ShapeGroup group;
+        group.add(std::make_unique<VariantShapeGroup<Text, Circle>>(std::move(sg)));
+
+        group.draw();
+        REQUIRE(group.shapes.size() == 1);
+    }
+}
+
+TEST_CASE("Render sinks")
+{
+    ShapeGroup sg;
+    sg.add(std::make_unique<Text>(10, 20, "text"));
+    sg.add(std::make_unique<Circle>(1, 2, 3));
+
+    const std::string expected_frame = "Rendering text 'text' at: [10, 20]\nDrawing circle at: [1, 2] r: 3\n";
+
+    SECTION("MemorySink")
+    {
+        MemorySink sink;
+        sg.draw(sink);
+
+        REQUIRE(sink.str() == expected_frame);
+    }
+
+    SECTION("StreamSink - frame is written in blocks")
+    {
+        std::ostringstream out;
+
+        {
+            StreamSink sink{out, 16};
+            sg.draw(sink);
+            sink.write(-42);
+        }
+
+        REQUIRE(out.str() == expected_frame + "-42");
+    }
+
+    SECTION("StreamSink - stream error is not thrown from destructor")
+    {
+        struct FailingBuffer : std::streambuf
+        {
+        protected:
+            int_type overflow(int_type) override
+            {
+                return traits_type::eof();
+            }
+        };
+
+        FailingBuffer buffer;
+        std::ostream out{&buffer};
+        out.exceptions(std::ios::badbit);
+
+        REQUIRE_NOTHROW([&] {
+            StreamSink sink{out};
+            sg.draw(sink);
+        }());
+        REQUIRE(out.bad());
+    }
+
+    SECTION("draw() without sink writes whole frame to std::cout")
+    {
+        std::ostringstream out;
+        std::streambuf* cout_buffer = std::cout.rdbuf(out.rdbuf());
+        sg.draw();
+        std::cout.rdbuf(cout_buffer);
+
+        REQUIRE(out.str() == expected_frame);
+    }
+
+    SECTION("FileSink")
+    {
+        const auto path = std::filesystem::temp_directory_path() / "render_sink_test.txt";
+
+        {
+            FileSink sink{path.string(), 8};
+            sg.draw(sink);
+        }
+
+        std::ifstream file{path};
+        const std::string content{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        REQUIRE(content == expected_frame);
+
+        std::filesystem::remove(path);
+    }
+}
+
+namespace
+{
+    // levels of nested groups - every group has fan_out children
+    std::unique_ptr<ShapeGroup> create_shape_tree(int depth, int fan_out, int& counter)
+    {
+        auto group = std::make_unique<ShapeGroup>();
+
+        for (int i = 0; i < fan_out; ++i)
+        {
+            ++counter;
+
+            if (depth > 1 && i % 3 == 0)
+                group->add(create_shape_tree(depth - 1, fan_out, counter));
+            else if (i % 2 == 0)
+                group->add(std::make_unique<Text>(counter, -counter, "text #" + std::to_string(counter)));
+            else
+                group->add(std::make_unique<Circle>(counter, counter, i));
+        }
+
+        return group;
+    }
+} // namespace
+
+TEST_CASE("ShapeGroup - parallel draw")
+{
+    int counter = 0;
+    auto tree = create_shape_tree(4, 20, counter);
+
+    MemorySink serial_output;
+    tree->draw(serial_output);
+
+    for (size_t thread_count : {1, 2, 4, 8})
+    {
+        DYNAMIC_SECTION("output is the same as from serial draw - threads: " << thread_count)
+        {
+            WorkStealingPool pool{thread_count};
+
+            MemorySink parallel_output;
+            tree->draw_parallel(parallel_output, pool);
+
+            REQUIRE(parallel_output.str() == serial_output.str());
+        }
+    }
+
+    SECTION("empty and single shape groups")
+    {
+        WorkStealingPool pool{2};
+
+        ShapeGroup empty;
+        MemorySink output;
+        empty.draw_parallel(output, pool);
+        REQUIRE(output.str().empty());
+
+        ShapeGroup single;
+        single.add(std::make_unique<Text>(1, 2, "one"));
+        single.draw_parallel(output, pool);
+        REQUIRE(output.str() == "Rendering text 'one' at: [1, 2]\n");
+    }
+}
+
+TEST_CASE("TaskGroup")
+{
+    WorkStealingPool pool{4};
+
+    SECTION("nested groups")
+    {
+        std::atomic<int> count{0};
+
+        TaskGroup outer{pool};
+        for (int i = 0; i < 10; ++i)
+        {
+            outer.run([&] {
+                TaskGroup inner{pool};
+                for (int j = 0; j < 10; ++j)
+                    inner.run([&] { ++count; });
+                inner.wait();
+            });
+        }
+        outer.wait();
+
+        REQUIRE(count == 100);
+    }
+
+    SECTION("exception is rethrown from wait")
+    {
+        TaskGroup tasks{pool};
+        tasks.run([] { throw std::runtime_error("error"); });
+
+        REQUIRE_THROWS_AS(tasks.wait(), std::runtime_error);
+    }
+
+    SECTION("task that cannot be submitted is not waited for")
+    {
+        struct UncopyableTask
+        {
+            UncopyableTask() = default;
+
+            UncopyableTask(const UncopyableTask&)
+            {
+                throw std::bad_alloc{};
+            }
+
+            void operator()() const
+            {
+            }
+        };
+
+        TaskGroup tasks{pool};
+
+        REQUIRE_THROWS_AS(tasks.run(UncopyableTask{}), std::bad_alloc);
+        tasks.wait(); // does not hang
+    }
+}
+
+TEST_CASE("ShapeGroup storage - benchmark", "[.][benchmark]")
+{
+    for (size_t count : {10'000, 100'000, 1'000'000})
+    {
+        ShapeGroup pointer_group;
+        BatchShapeGroup<Text, Circle> batch_group;
+        VariantShapeGroup<Text, Circle> variant_group;
+        variant_group.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int pos = static_cast<int>(i);
+            if (i % 2 == 0)
+            {
+                pointer_group.add(std::make_unique<Text>(pos, pos, "label"));
+                batch_group.emplace<Text>(pos, pos, "label");
+                variant_group.emplace<Text>(pos, pos, "label");
+            }
+            else
+            {
+                pointer_group.add(std::make_unique<Circle>(pos, pos, 10));
+                batch_group.emplace<Circle>(pos, pos, 10);
+                variant_group.emplace<Circle>(pos, pos, 10);
+            }
+        }
+
+        NullSink sink;
+        const std::string suffix = " - " + std::to_string(count) + " shapes";
+
+        BENCHMARK("vector<unique_ptr<Shape>>" + suffix)
+        {
+            pointer_group.draw(sink);
+        };
+
+        BENCHMARK("BatchShapeGroup" + suffix)
+        {
+            batch_group.draw(sink);
+        };
+
+        BENCHMARK("VariantShapeGroup" + suffix)
+        {
+            variant_group.draw(sink);
+        };
+    }
+}
+
+TEST_CASE("frame output - benchmark", "[.][benchmark]")
+{
+    constexpr int count = 100'000;
+
+    ShapeGroup sg;
+    for (int i = 0; i < count; ++i)
+        sg.add(std::make_unique<Text>(i, i, "label"));
+
+    const auto path = std::filesystem::temp_directory_path() / "frame_output_benchmark.txt";
+
+    BENCHMARK("std::ofstream with flush per shape")
+    {
+        std::ofstream out{path};
+        for (const auto& shape : sg.shapes)
+        {
+            const Text& text = static_cast<const Text&>(*shape);
+            out << "Rendering text '" << text.text_view() << "' at: [" << 0 << ", " << 0 << "]" << std::endl;
+        }
+    };
+
+    BENCHMARK("FileSink")
+    {
+        FileSink sink{path.string()};
+        sg.draw(sink);
+    };
+
+    BENCHMARK("MemorySink")
+    {
+        MemorySink sink;
+        sg.draw(sink);
+        return sink.str().size();
+    };
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ShapeGroup - parallel draw benchmark", "[.][benchmark]")
+{
+    int counter = 0;
+    auto tree = create_shape_tree(5, 40, counter); // ~4M shapes
+
+    WorkStealingPool pool;
+
+    BENCHMARK("serial draw")
+    {
+        MemorySink sink;
+        tree->draw(sink);
+        return sink.str().size();
+    };
+
+    BENCHMARK("parallel draw - " + std::to_string(pool.size()) + " threads")
+    {
+        MemorySink sink;
+        tree->draw_parallel(sink, pool);
+        return sink.str().size();
+    };
+}
@@ -0,0 +1,257 @@
+#ifndef WORK_STEALING_POOL_HPP_
+#define WORK_STEALING_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// WorkStealingPool - every worker has its own task queue
+//
+// Workers take tasks from the back of their own queue (LIFO - the most recently spawned subtask
+// is hot in cache) and steal from the front of other queues when their own is empty.
+// Tasks submitted from a worker go to its own queue, tasks from other threads are spread round-robin.
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> pending_tasks_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::mutex wake_mtx_;
+    std::condition_variable wake_cv_;
+    bool stop_{false};
+
+    struct WorkerContext
+    {
+        const WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static WorkerContext& this_worker() noexcept
+    {
+        thread_local WorkerContext context;
+        return context;
+    }
+
+public:
+    explicit WorkStealingPool(size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        for (size_t i = 0; i < thread_count; ++i)
+            queues_.push_back(std::make_unique<WorkerQueue>());
+
+        for (size_t i = 0; i < thread_count; ++i)
+            threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard lk{wake_mtx_};
+            stop_ = true;
+        }
+        wake_cv_.notify_all();
+
+        for (auto& thd : threads_)
+            thd.join();
+    }
+
+    size_t size() const noexcept
+    {
+        return threads_.size();
+    }
+
+    // tasks submitted and not taken by any thread yet
+    size_t pending_tasks() const noexcept
+    {
+        return pending_tasks_.load(std::memory_order_relaxed);
+    }
+
+    void submit(Task task)
+    {
+        const WorkerContext& worker = this_worker();
+        const size_t index = (worker.pool == this) ? worker.index : next_queue_++ % queues_.size();
+
+        {
+            std::lock_guard lk{wake_mtx_};
+            ++pending_tasks_;
+        }
+
+        {
+            std::lock_guard lk{queues_[index]->mtx};
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+
+        wake_cv_.notify_one();
+    }
+
+    // runs one pending task on the calling thread - waiting threads help instead of blocking
+    bool try_run_pending_task()
+    {
+        const WorkerContext& worker = this_worker();
+        const size_t index = (worker.pool == this) ? worker.index : 0;
+
+        if (std::optional<Task> task = take_task(index))
+        {
+            (*task)();
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    void worker_loop(size_t index)
+    {
+        this_worker() = WorkerContext{this, index};
+
+        while (true)
+        {
+            if (std::optional<Task> task = take_task(index))
+            {
+                (*task)();
+                continue;
+            }
+
+            std::unique_lock lk{wake_mtx_};
+            wake_cv_.wait(lk, [this] { return stop_ || pending_tasks_ > 0; });
+
+            if (stop_ && pending_tasks_ == 0)
+                return;
+        }
+    }
+
+    std::optional<Task> take_task(size_t index)
+    {
+        std::optional<Task> task = pop_back(*queues_[index]);
+
+        for (size_t i = 1; !task && i < queues_.size(); ++i)
+            task = pop_front(*queues_[(index + i) % queues_.size()]);
+
+        if (task)
+            --pending_tasks_;
+
+        return task;
+    }
+
+    static std::optional<Task> pop_back(WorkerQueue& queue)
+    {
+        std::lock_guard lk{queue.mtx};
+
+        if (queue.tasks.empty())
+            return std::nullopt;
+
+        Task task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+
+        return task;
+    }
+
+    static std::optional<Task> pop_front(WorkerQueue& queue)
+    {
+        std::lock_guard lk{queue.mtx};
+
+        if (queue.tasks.empty())
+            return std::nullopt;
+
+        Task task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+
+        return task;
+    }
+};
+
+// TaskGroup - fork-join scope for tasks run on WorkStealingPool
+//
+// wait() executes pending tasks of the pool while waiting, so groups may be nested inside tasks.
+// The first exception thrown by a task is rethrown from wait().
+class TaskGroup
+{
+    WorkStealingPool& pool_;
+    std::atomic<size_t> pending_{0};
+    std::mutex error_mtx_;
+    std::exception_ptr error_;
+
+public:
+    explicit TaskGroup(WorkStealingPool& pool)
+        : pool_{pool}
+    {
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        wait_for_tasks();
+    }
+
+    template <typename F>
+    void run(F f)
+    {
+        ++pending_;
+
+        try
+        {
+            pool_.submit([this, f = std::move(f)] {
+                try
+                {
+                    f();
+                }
+                catch (...)
+                {
+                    std::lock_guard lk{error_mtx_};
+                    if (!error_)
+                        error_ = std::current_exception();
+                }
+
+                pending_.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        catch (...)
+        {
+            --pending_; // task was not queued - wait() must not wait for it
+            throw;
+        }
+    }
+
+    void wait()
+    {
+        wait_for_tasks();
+
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+private:
+    void wait_for_tasks() noexcept
+    {
+        while (pending_.load(std::memory_order_acquire) != 0)
+        {
+            if (!pool_.try_run_pending_task())
+                std::this_thread::yield();
+        }
+    }
+};
+
+#endif /*WORK_STEALING_POOL_HPP_*/
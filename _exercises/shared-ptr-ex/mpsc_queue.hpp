@@ -0,0 +1,100 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+// BoundedMpscQueue - lock-free ring buffer for many producers and a single consumer
+//
+// Every slot has a sequence number telling whether it is ready for a producer (pos)
+// or for the consumer (pos + 1). Producers reserve positions with CAS on enqueue_pos_.
+template <typename T>
+class BoundedMpscQueue
+{
+    static constexpr size_t cache_line_size = 64;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    alignas(cache_line_size) std::atomic<size_t> enqueue_pos_{0};
+    alignas(cache_line_size) size_t dequeue_pos_{0}; // owned by the consumer
+
+public:
+    // capacity is rounded up to a power of 2
+    explicit BoundedMpscQueue(size_t capacity)
+        : slots_{std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))}
+        , mask_{std::bit_ceil(std::max<size_t>(capacity, 2)) - 1}
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    size_t capacity() const noexcept
+    {
+        return mask_ + 1;
+    }
+
+    // returns false when queue is full
+    bool try_push(T value)
+    {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // consumer only - returns false when queue is empty
+    bool try_pop(T& value)
+    {
+        Slot& slot = slots_[dequeue_pos_ & mask_];
+
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+            return false;
+
+        value = std::move(slot.value);
+        slot.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+
+        return true;
+    }
+};
+
+#endif // MPSC_QUEUE_HPP
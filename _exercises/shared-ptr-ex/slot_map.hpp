@@ -0,0 +1,164 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// SlotMap - O(1) insert/erase/lookup with stable, generation-checked keys
+//
+// Values are stored densely (erase moves the last value into the hole), so iteration is contiguous.
+// A slot keeps the position of its value and a generation incremented on every erase -
+// a key of an erased value never matches a reused slot.
+template <typename T>
+class SlotMap
+{
+public:
+    struct Key
+    {
+        uint32_t index = npos;
+        uint32_t generation = 0;
+
+        friend bool operator==(const Key&, const Key&) = default;
+    };
+
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+private:
+    struct Slot
+    {
+        uint32_t value_index; // next free slot when the slot is not used
+        uint32_t generation;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<T> values_;
+    std::vector<uint32_t> value_slots_; // slot of values_[i]
+    uint32_t free_head_ = npos;
+
+public:
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    // strong guarantee - bookkeeping vectors are grown before the value is stored,
+    // a free slot is taken only when nothing can throw any more
+    Key insert(T value)
+    {
+        reserve_one_more(value_slots_);
+        if (free_head_ == npos)
+            reserve_one_more(slots_);
+
+        values_.push_back(std::move(value));
+
+        uint32_t index;
+
+        if (free_head_ != npos)
+        {
+            index = free_head_;
+            free_head_ = slots_[index].value_index;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{npos, 0});
+        }
+
+        value_slots_.push_back(index);
+        slots_[index].value_index = static_cast<uint32_t>(values_.size() - 1);
+
+        return Key{index, slots_[index].generation};
+    }
+
+    // returns false if the key is stale
+    bool erase(Key key)
+    {
+        if (!contains(key))
+            return false;
+
+        Slot& slot = slots_[key.index];
+        const uint32_t hole = slot.value_index;
+
+        if (hole != values_.size() - 1)
+        {
+            values_[hole] = std::move(values_.back());
+            value_slots_[hole] = value_slots_.back();
+            slots_[value_slots_[hole]].value_index = hole;
+        }
+
+        values_.pop_back();
+        value_slots_.pop_back();
+
+        ++slot.generation;
+        slot.value_index = free_head_;
+        free_head_ = key.index;
+
+        return true;
+    }
+
+    bool contains(Key key) const noexcept
+    {
+        return key.index < slots_.size() && slots_[key.index].generation == key.generation;
+    }
+
+    T* find(Key key) noexcept
+    {
+        return contains(key) ? &values_[slots_[key.index].value_index] : nullptr;
+    }
+
+    const T* find(Key key) const noexcept
+    {
+        return contains(key) ? &values_[slots_[key.index].value_index] : nullptr;
+    }
+
+    size_t size() const noexcept
+    {
+        return values_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    void clear() noexcept
+    {
+        while (!value_slots_.empty())
+        {
+            const uint32_t index = value_slots_.back();
+            erase(Key{index, slots_[index].generation});
+        }
+    }
+
+    iterator begin() noexcept
+    {
+        return values_.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return values_.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return values_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return values_.end();
+    }
+
+private:
+    template <typename U>
+    static void reserve_one_more(std::vector<U>& vec)
+    {
+        if (vec.size() == vec.capacity())
+            vec.reserve(std::max<size_t>(1, 2 * vec.size()));
+    }
+};
+
+#endif // SLOT_MAP_HPP
@@ -0,0 +1,581 @@
+#ifndef SUBJECT_HPP
+#define SUBJECT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "mpsc_queue.hpp"
+#include "slot_map.hpp"
+
+// StateChange - event with a message built on first access
+class StateChange
+{
+    int state_;
+    mutable std::optional<std::string> message_;
+
+public:
+    explicit StateChange(int state) noexcept
+        : state_{state}
+    {
+    }
+
+    int state() const noexcept
+    {
+        return state_;
+    }
+
+    const std::string& message() const
+    {
+        if (!message_)
+            message_ = "Changed state on: " + std::to_string(state_);
+
+        return *message_;
+    }
+
+    bool is_message_built() const noexcept
+    {
+        return message_.has_value();
+    }
+};
+
+class Observer
+{
+public:
+    virtual void update(const std::string& event_args) = 0;
+
+    // observers that need only the new state may override it - the message is never built then
+    virtual void on_state_changed(const StateChange& change)
+    {
+        update(change.message());
+    }
+
+    virtual ~Observer() = default;
+};
+
+// ObserverRegistry - thread-safe list of observers
+//
+// Observers are kept in an immutable vector published through atomic<shared_ptr> (RCU-style).
+// for_each() iterates over a snapshot with no mutex held while calling observers - registration
+// copies the vector and publishes a new version. atomic<shared_ptr> is not lock-free in libstdc++ -
+// load/store briefly take its internal lock bit. Expired observers are skipped during iteration
+// and pruned in batches.
+template <typename TObserver>
+class ObserverRegistry
+{
+    using ObserverList = std::vector<std::weak_ptr<TObserver>>;
+
+    static constexpr size_t prune_threshold = 64;
+
+    std::atomic<std::shared_ptr<const ObserverList>> observers_;
+    std::mutex writer_mtx_; // serializes copy-on-write updates
+    std::atomic<size_t> expired_seen_{0};
+
+    static bool is_same_owner(const std::weak_ptr<TObserver>& a, const std::weak_ptr<TObserver>& b) noexcept
+    {
+        return !a.owner_before(b) && !b.owner_before(a);
+    }
+
+public:
+    ObserverRegistry()
+        : observers_(std::make_shared<const ObserverList>())
+    {
+    }
+
+    ObserverRegistry(const ObserverRegistry&) = delete;
+    ObserverRegistry& operator=(const ObserverRegistry&) = delete;
+
+    void add(std::weak_ptr<TObserver> observer)
+    {
+        std::lock_guard lk{writer_mtx_};
+
+        auto current = observers_.load(std::memory_order_acquire);
+        if (std::any_of(current->begin(), current->end(), [&](const auto& o) { return is_same_owner(o, observer); }))
+            return;
+
+        auto updated = std::make_shared<ObserverList>();
+        updated->reserve(current->size() + 1);
+        std::copy_if(current->begin(), current->end(), std::back_inserter(*updated), [](const auto& o) { return !o.expired(); });
+        updated->push_back(std::move(observer));
+
+        observers_.store(std::move(updated), std::memory_order_release);
+    }
+
+    void remove(const std::weak_ptr<TObserver>& observer)
+    {
+        std::lock_guard lk{writer_mtx_};
+
+        auto current = observers_.load(std::memory_order_acquire);
+
+        auto updated = std::make_shared<ObserverList>();
+        updated->reserve(current->size());
+        std::copy_if(current->begin(), current->end(), std::back_inserter(*updated), [&](const auto& o) { return !o.expired() && !is_same_owner(o, observer); });
+
+        observers_.store(std::move(updated), std::memory_order_release);
+    }
+
+    size_t size() const
+    {
+        return observers_.load(std::memory_order_acquire)->size();
+    }
+
+    template <typename F>
+    void for_each(F&& f)
+    {
+        const auto snapshot = observers_.load(std::memory_order_acquire);
+
+        size_t expired = 0;
+        for (const auto& weak_observer : *snapshot)
+        {
+            if (std::shared_ptr<TObserver> observer = weak_observer.lock())
+                f(*observer);
+            else
+                ++expired;
+        }
+
+        if (expired != 0 && expired_seen_.fetch_add(expired, std::memory_order_relaxed) + expired >= prune_threshold)
+            prune_expired();
+    }
+
+private:
+    // skipped when another writer holds the lock - expired observers will be pruned later
+    void prune_expired()
+    {
+        std::unique_lock lk{writer_mtx_, std::try_to_lock};
+        if (!lk.owns_lock())
+            return;
+
+        expired_seen_.store(0, std::memory_order_relaxed);
+
+        auto current = observers_.load(std::memory_order_acquire);
+
+        auto updated = std::make_shared<ObserverList>();
+        updated->reserve(current->size());
+        std::copy_if(current->begin(), current->end(), std::back_inserter(*updated), [](const auto& o) { return !o.expired(); });
+
+        observers_.store(std::move(updated), std::memory_order_release);
+    }
+};
+
+namespace Detail
+{
+    // SubscriptionList - observers subscribed with RAII tokens
+    //
+    // Kept in a slot map - subscribe/unsubscribe are O(1) and never rebuild the whole list.
+    // They only mark the notification snapshot as dirty; the first for_each() after a change
+    // rebuilds it once and publishes it through atomic<shared_ptr>. Observers are called
+    // with no mutex held, so an observer may subscribe or unsubscribe during notification.
+    // Unsubscribing does not allocate.
+    class SubscriptionList
+    {
+        using ObserverList = std::vector<std::weak_ptr<Observer>>;
+
+        mutable std::mutex mtx_; // serializes access to the slot map
+        SlotMap<std::weak_ptr<Observer>> observers_;
+        std::atomic<std::shared_ptr<const ObserverList>> snapshot_;
+        std::atomic<bool> is_dirty_{false};
+
+        std::shared_ptr<const ObserverList> current_snapshot()
+        {
+            if (!is_dirty_.load(std::memory_order_acquire))
+                return snapshot_.load(std::memory_order_acquire);
+
+            std::lock_guard lk{mtx_};
+
+            if (is_dirty_.load(std::memory_order_relaxed))
+            {
+                std::shared_ptr<const ObserverList> updated;
+
+                if (!observers_.empty())
+                    updated = std::make_shared<const ObserverList>(observers_.begin(), observers_.end());
+
+                snapshot_.store(std::move(updated), std::memory_order_release);
+                is_dirty_.store(false, std::memory_order_release); // published after the new snapshot
+            }
+
+            return snapshot_.load(std::memory_order_acquire);
+        }
+
+    public:
+        using Key = SlotMap<std::weak_ptr<Observer>>::Key;
+
+        Key add(std::weak_ptr<Observer> observer)
+        {
+            std::lock_guard lk{mtx_};
+            Key key = observers_.insert(std::move(observer));
+            is_dirty_.store(true, std::memory_order_release);
+            return key;
+        }
+
+        bool remove(Key key)
+        {
+            std::lock_guard lk{mtx_};
+
+            if (!observers_.erase(key))
+                return false;
+
+            is_dirty_.store(true, std::memory_order_release);
+            return true;
+        }
+
+        bool contains(Key key) const
+        {
+            std::lock_guard lk{mtx_};
+            return observers_.contains(key);
+        }
+
+        size_t size() const
+        {
+            std::lock_guard lk{mtx_};
+            return observers_.size();
+        }
+
+        template <typename F>
+        void for_each(F&& f)
+        {
+            const auto snapshot = current_snapshot();
+
+            if (!snapshot)
+                return;
+
+            for (const auto& weak_observer : *snapshot)
+            {
+                if (std::shared_ptr<Observer> observer = weak_observer.lock())
+                    f(*observer);
+            }
+        }
+    };
+} // namespace Detail
+
+// Subscription - RAII token returned by Subject::subscribe()
+//
+// Observer is unsubscribed when the token is destroyed or reset. Token may outlive the subject.
+class [[nodiscard]] Subscription
+{
+    std::weak_ptr<Detail::SubscriptionList> list_;
+    Detail::SubscriptionList::Key key_{};
+
+public:
+    Subscription() = default;
+
+    Subscription(std::weak_ptr<Detail::SubscriptionList> list, Detail::SubscriptionList::Key key) noexcept
+        : list_{std::move(list)}
+        , key_{key}
+    {
+    }
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    Subscription(Subscription&& other) noexcept
+        : list_{std::move(other.list_)}
+        , key_{std::exchange(other.key_, Detail::SubscriptionList::Key{})}
+    {
+    }
+
+    Subscription& operator=(Subscription&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            list_ = std::move(other.list_);
+            key_ = std::exchange(other.key_, Detail::SubscriptionList::Key{});
+        }
+
+        return *this;
+    }
+
+    ~Subscription()
+    {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if (auto list = list_.lock())
+            list->remove(key_);
+
+        list_.reset();
+        key_ = Detail::SubscriptionList::Key{};
+    }
+
+    bool is_active() const
+    {
+        auto list = list_.lock();
+        return list && list->contains(key_);
+    }
+
+    explicit operator bool() const
+    {
+        return is_active();
+    }
+};
+
+// Subject - thread-safe subject notifying about state changes
+class Subject
+{
+    std::atomic<int> state_;
+    ObserverRegistry<Observer> observers_;
+    std::shared_ptr<Detail::SubscriptionList> subscriptions_;
+
+public:
+    Subject()
+        : state_(0)
+        , subscriptions_(std::make_shared<Detail::SubscriptionList>())
+    {
+    }
+
+    Subject(const Subject&) = delete;
+    Subject& operator=(const Subject&) = delete;
+
+    void register_observer(std::weak_ptr<Observer> observer)
+    {
+        observers_.add(std::move(observer));
+    }
+
+    void unregister_observer(std::weak_ptr<Observer> observer)
+    {
+        observers_.remove(observer);
+    }
+
+    // O(1) alternative to register_observer() - observer stays subscribed while the token is alive
+    Subscription subscribe(std::weak_ptr<Observer> observer)
+    {
+        return Subscription{subscriptions_, subscriptions_->add(std::move(observer))};
+    }
+
+    size_t observer_count() const
+    {
+        return observers_.size() + subscriptions_->size();
+    }
+
+    void set_state(int new_state)
+    {
+        if (exchange_state(new_state))
+        {
+            notify(StateChange{new_state});
+        }
+    }
+
+protected:
+    // returns true if the state was changed
+    bool exchange_state(int new_state) noexcept
+    {
+        return state_.exchange(new_state) != new_state;
+    }
+
+    void notify(const StateChange& change)
+    {
+        auto deliver = [&change](Observer& observer) { observer.on_state_changed(change); };
+
+        observers_.for_each(deliver);
+        subscriptions_->for_each(deliver);
+    }
+};
+
+namespace Typed
+{
+    // Observer<Event> - events are passed by value, no strings are built
+    template <typename Event>
+    class Observer
+    {
+    public:
+        virtual void update(Event event) = 0;
+        virtual ~Observer() = default;
+    };
+
+    template <typename Event>
+    class Subject
+    {
+        ObserverRegistry<Observer<Event>> observers_;
+
+    public:
+        Subject() = default;
+
+        void register_observer(std::weak_ptr<Observer<Event>> observer)
+        {
+            observers_.add(std::move(observer));
+        }
+
+        void unregister_observer(std::weak_ptr<Observer<Event>> observer)
+        {
+            observers_.remove(observer);
+        }
+
+        size_t observer_count() const
+        {
+            return observers_.size();
+        }
+
+        void notify(Event event)
+        {
+            observers_.for_each([event](Observer<Event>& observer) { observer.update(event); });
+        }
+    };
+
+    struct StateChanged
+    {
+        int state;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    static_assert(std::is_trivially_copyable_v<StateChanged>);
+
+    inline std::string to_message(const StateChanged& event)
+    {
+        return "Changed state on: " + std::to_string(event.state);
+    }
+
+    // StringObserverAdapter - forwards typed events to string-based ::Observer
+    //
+    // Message is built with to_message(event) found by ADL. Target is not kept alive by the adapter.
+    template <typename Event>
+    class StringObserverAdapter : public Observer<Event>
+    {
+        std::weak_ptr<::Observer> target_;
+
+    public:
+        explicit StringObserverAdapter(std::weak_ptr<::Observer> target)
+            : target_{std::move(target)}
+        {
+        }
+
+        void update(Event event) override
+        {
+            if (auto target = target_.lock())
+                target->update(to_message(event));
+        }
+    };
+} // namespace Typed
+
+enum class Coalescing
+{
+    none,       // every change is delivered
+    latest_wins // only the latest of queued changes is delivered
+};
+
+// AsyncSubject - state changes are delivered to observers on a dispatcher thread
+//
+// set_state() only enqueues the new state into a bounded MPSC queue (it waits only when the queue is full).
+// The dispatcher takes all queued changes at once and delivers them according to Coalescing policy.
+class AsyncSubject : public Subject
+{
+    static constexpr size_t max_batch_size = 256;
+
+    BoundedMpscQueue<int> queue_;
+    Coalescing coalescing_;
+    std::atomic<size_t> enqueued_{0};
+    std::atomic<size_t> delivered_{0};
+    std::atomic<bool> stop_{false};
+    std::thread dispatcher_;
+
+public:
+    static constexpr size_t default_queue_capacity = 1024;
+
+    explicit AsyncSubject(Coalescing coalescing = Coalescing::none, size_t queue_capacity = default_queue_capacity)
+        : queue_{queue_capacity}
+        , coalescing_{coalescing}
+        , dispatcher_{[this] { dispatch(); }}
+    {
+    }
+
+    // pending changes are delivered before destruction
+    ~AsyncSubject()
+    {
+        stop_.store(true, std::memory_order_release);
+        enqueued_.fetch_add(1, std::memory_order_release); // wakes up the dispatcher
+        enqueued_.notify_one();
+        dispatcher_.join();
+    }
+
+    void set_state(int new_state)
+    {
+        while (!try_set_state(new_state))
+            std::this_thread::yield();
+    }
+
+    // returns false when the queue is full
+    bool try_set_state(int new_state)
+    {
+        if (!queue_.try_push(new_state))
+            return false;
+
+        enqueued_.fetch_add(1, std::memory_order_release);
+        enqueued_.notify_one();
+
+        return true;
+    }
+
+    // waits until all changes enqueued so far are delivered
+    void flush()
+    {
+        const size_t target = enqueued_.load(std::memory_order_acquire);
+
+        for (size_t delivered = delivered_.load(std::memory_order_acquire); delivered < target; delivered = delivered_.load(std::memory_order_acquire))
+            delivered_.wait(delivered, std::memory_order_acquire);
+    }
+
+private:
+    void dispatch()
+    {
+        std::vector<int> batch;
+        batch.reserve(max_batch_size);
+        size_t consumed = 0;
+
+        while (true)
+        {
+            int state;
+            while (batch.size() < max_batch_size && queue_.try_pop(state))
+                batch.push_back(state);
+
+            if (batch.empty())
+            {
+                if (stop_.load(std::memory_order_acquire))
+                    return;
+
+                const size_t enqueued = enqueued_.load(std::memory_order_acquire);
+                if (enqueued == consumed)
+                    enqueued_.wait(enqueued, std::memory_order_acquire);
+                else
+                    std::this_thread::yield(); // item is reserved by a producer but not published yet
+
+                continue;
+            }
+
+            deliver(batch);
+
+            consumed += batch.size();
+            batch.clear();
+
+            delivered_.store(consumed, std::memory_order_release);
+            delivered_.notify_all();
+        }
+    }
+
+    void deliver(const std::vector<int>& batch)
+    {
+        if (coalescing_ == Coalescing::latest_wins)
+        {
+            if (exchange_state(batch.back()))
+                notify(StateChange{batch.back()});
+
+            return;
+        }
+
+        for (int state : batch)
+        {
+            if (exchange_state(state))
+                notify(StateChange{state});
+        }
+    }
+};
+
+#endif // SUBJECT_HPP
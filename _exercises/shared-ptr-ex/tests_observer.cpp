@@ -1,112 +1,605 @@
+#include "subject.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
 
-class Observer
+class ConcreteObserver1 : public Observer
 {
 public:
-    virtual void update(const std::string& event_args) = 0;
-    virtual ~Observer() = default;
+    void update(const std::string& event) override
+    {
+        std::cout << "ConcreteObserver1: " << event << std::endl;
+    }
 };
 
-class Subject
+class ConcreteObserver2 : public Observer, public std::enable_shared_from_this<ConcreteObserver2>
 {
-    int state_;
-    std::set<std::weak_ptr<Observer>, std::owner_less<std::weak_ptr<Observer>>> observers_;
-
 public:
-    Subject() : state_(0)
+    void update(const std::string& event) override
     {
+        std::cout << "ConcreteObserver2: " << event << std::endl;
     }
 
-    void register_observer(std::weak_ptr<Observer> observer)
+    void register_me(Subject& subject)
     {
-        observers_.insert(observer);
+        // subject.register_observer(std::shared_ptr<Observer>(this)); // ERROR - cannot convert this to shared_ptr this way
+        subject.register_observer(shared_from_this());
     }
+};
+
+TEST_CASE("using observer pattern")
+{
+    using namespace std;
+
+    Subject s;
+
+    auto o1 = std::make_shared<ConcreteObserver1>();
+    s.register_observer(o1);
 
-    void unregister_observer(std::weak_ptr<Observer> observer)
     {
-        observers_.erase(observer);
+        auto o2 = std::make_shared<ConcreteObserver2>();
+        //s.register_observer(o2);
+        o2->register_me(s);
+
+        s.set_state(1);
+
+        o2.reset();
+
+        cout << "End of scope." << endl;
     }
 
-    void set_state(int new_state)
+    s.set_state(2);
+}
+
+namespace
+{
+    struct CountingObserver : Observer
     {
-        if (state_ != new_state)
+        std::atomic<int> updates{0};
+
+        void update(const std::string&) override
         {
-            state_ = new_state;
-            notify("Changed state on: " + std::to_string(state_));
+            ++updates;
         }
+    };
+} // namespace
+
+TEST_CASE("Subject - registration")
+{
+    Subject s;
+    auto o1 = std::make_shared<CountingObserver>();
+    auto o2 = std::make_shared<CountingObserver>();
+
+    SECTION("observer is registered once")
+    {
+        s.register_observer(o1);
+        s.register_observer(o1);
+        s.set_state(1);
+
+        REQUIRE(s.observer_count() == 1);
+        REQUIRE(o1->updates == 1);
+    }
+
+    SECTION("unregistered observer is not notified")
+    {
+        s.register_observer(o1);
+        s.register_observer(o2);
+        s.unregister_observer(o1);
+        s.set_state(1);
+
+        REQUIRE(o1->updates == 0);
+        REQUIRE(o2->updates == 1);
     }
 
-protected:
-    void notify(const std::string& event_args)
+    SECTION("expired observers are pruned in batches")
     {
-        for (auto it = observers_.begin(); it != observers_.end();)
+        s.register_observer(o1);
         {
-            auto& weak_observer = *it;
-            std::shared_ptr<Observer> observer = weak_observer.lock();
-            if(observer)
-            {
-                observer->update(event_args);
-                ++it;
-            }
-            else
+            auto temp = std::make_shared<CountingObserver>();
+            s.register_observer(temp);
+        }
+
+        REQUIRE(s.observer_count() == 2);
+
+        for (int i = 1; i <= 100; ++i)
+            s.set_state(i);
+
+        REQUIRE(s.observer_count() == 1);
+        REQUIRE(o1->updates == 100);
+    }
+}
+
+TEST_CASE("Subject - concurrent notify & registration")
+{
+    Subject s;
+    auto permanent = std::make_shared<CountingObserver>();
+    s.register_observer(permanent);
+
+    constexpr int notifications_per_thread = 10'000;
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> notifiers;
+    for (int t = 0; t < 2; ++t)
+    {
+        notifiers.emplace_back([&s, t] {
+            for (int i = 0; i < notifications_per_thread; ++i)
+                s.set_state(t * notifications_per_thread + i + 1);
+        });
+    }
+
+    std::thread registrar{[&] {
+        while (!done)
+        {
+            auto temp = std::make_shared<CountingObserver>();
+            s.register_observer(temp);
+            s.unregister_observer(temp);
+
+            auto short_lived = std::make_shared<CountingObserver>();
+            s.register_observer(short_lived);
+        } // short_lived expires - pruned by notify or next registration
+    }};
+
+    for (auto& thd : notifiers)
+        thd.join();
+    done = true;
+    registrar.join();
+
+    REQUIRE(permanent->updates > 0);
+    REQUIRE(permanent->updates <= 2 * notifications_per_thread);
+    REQUIRE(s.observer_count() <= 2);
+}
+
+namespace
+{
+    // records states without asking for messages
+    struct StateRecorder : Observer
+    {
+        std::vector<int> states;
+        bool message_requested = false;
+
+        void update(const std::string&) override
+        {
+            message_requested = true;
+        }
+
+        void on_state_changed(const StateChange& change) override
+        {
+            states.push_back(change.state());
+            message_requested |= change.is_message_built();
+        }
+    };
+
+    struct MessageRecorder : Observer
+    {
+        std::vector<std::string> messages;
+
+        void update(const std::string& event) override
+        {
+            messages.push_back(event);
+        }
+    };
+} // namespace
+
+TEST_CASE("StateChange - message is built lazily")
+{
+    StateChange change{42};
+    REQUIRE_FALSE(change.is_message_built());
+
+    REQUIRE(change.message() == "Changed state on: 42");
+    REQUIRE(change.is_message_built());
+}
+
+TEST_CASE("AsyncSubject")
+{
+    SECTION("every change is delivered in order")
+    {
+        auto recorder = std::make_shared<StateRecorder>();
+        auto messages = std::make_shared<MessageRecorder>();
+
+        AsyncSubject s{Coalescing::none, 16};
+        s.register_observer(recorder);
+        s.register_observer(messages);
+
+        std::vector<int> expected;
+        for (int i = 1; i <= 1'000; ++i)
+        {
+            s.set_state(i);
+            expected.push_back(i);
+        }
+        s.flush();
+
+        REQUIRE(recorder->states == expected);
+        REQUIRE_FALSE(recorder->message_requested);
+        REQUIRE(messages->messages.size() == 1'000);
+        REQUIRE(messages->messages.back() == "Changed state on: 1000");
+    }
+
+    SECTION("latest wins - queued changes are coalesced")
+    {
+        auto recorder = std::make_shared<StateRecorder>();
+
+        AsyncSubject s{Coalescing::latest_wins};
+        s.register_observer(recorder);
+
+        for (int i = 1; i <= 1'000; ++i)
+            s.set_state(i);
+        s.flush();
+
+        REQUIRE(!recorder->states.empty());
+        REQUIRE(recorder->states.size() <= 1'000);
+        REQUIRE(recorder->states.back() == 1'000);
+        REQUIRE(std::is_sorted(recorder->states.begin(), recorder->states.end()));
+    }
+
+    SECTION("many producers")
+    {
+        auto counter = std::make_shared<CountingObserver>();
+
+        {
+            AsyncSubject s{Coalescing::none, 64};
+            s.register_observer(counter);
+
+            std::vector<std::thread> producers;
+            for (int t = 0; t < 4; ++t)
             {
-                it = observers_.erase(it);
+                producers.emplace_back([&s, t] {
+                    for (int i = 0; i < 1'000; ++i)
+                        s.set_state(t * 1'000 + i + 1); // every value is different from previous one
+                });
             }
+
+            for (auto& thd : producers)
+                thd.join();
+        } // pending changes are delivered before destruction
+
+        REQUIRE(counter->updates > 0);
+        REQUIRE(counter->updates <= 4'000);
+    }
+}
+
+TEST_CASE("BoundedMpscQueue")
+{
+    BoundedMpscQueue<int> queue{3};
+    REQUIRE(queue.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(queue.try_push(i));
+    REQUIRE_FALSE(queue.try_push(4));
+
+    int value;
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.try_push(4));
+
+    std::vector<int> rest;
+    while (queue.try_pop(value))
+        rest.push_back(value);
+
+    REQUIRE(rest == std::vector<int>{1, 2, 3, 4});
+}
+
+namespace
+{
+    struct TelemetryCollector : Typed::Observer<Typed::StateChanged>
+    {
+        long long sum = 0;
+        std::chrono::steady_clock::time_point last_timestamp{};
+
+        void update(Typed::StateChanged event) override
+        {
+            sum += event.state;
+            last_timestamp = event.timestamp;
         }
+    };
+} // namespace
+
+TEST_CASE("Typed subject & observers")
+{
+    using Typed::StateChanged;
+
+    Typed::Subject<StateChanged> s;
+
+    auto collector = std::make_shared<TelemetryCollector>();
+    s.register_observer(collector);
+
+    SECTION("events are passed by value")
+    {
+        const auto now = std::chrono::steady_clock::now();
+        s.notify(StateChanged{1, now});
+        s.notify(StateChanged{2, now});
+
+        REQUIRE(collector->sum == 3);
+        REQUIRE(collector->last_timestamp == now);
     }
-};
 
-class ConcreteObserver1 : public Observer
+    SECTION("string adapter - legacy observers still work")
+    {
+        auto legacy = std::make_shared<MessageRecorder>();
+        auto adapter = std::make_shared<Typed::StringObserverAdapter<StateChanged>>(legacy);
+        s.register_observer(adapter);
+
+        auto o1 = std::make_shared<ConcreteObserver1>();
+        auto adapter1 = std::make_shared<Typed::StringObserverAdapter<StateChanged>>(o1);
+        s.register_observer(adapter1);
+
+        s.notify(StateChanged{42, std::chrono::steady_clock::now()});
+
+        REQUIRE(legacy->messages == std::vector<std::string>{"Changed state on: 42"});
+        REQUIRE(collector->sum == 42);
+    }
+}
+
+TEST_CASE("Subject notifications - benchmark", "[.][benchmark]")
 {
-public:
-    void update(const std::string& event) override
+    constexpr int observer_count = 100;
+
+    struct StringObserver : Observer
     {
-        std::cout << "ConcreteObserver1: " << event << std::endl;
+        size_t length = 0;
+
+        void update(const std::string& event) override
+        {
+            length += event.size();
+        }
+    };
+
+    struct TypedObserver : Typed::Observer<Typed::StateChanged>
+    {
+        long long sum = 0;
+
+        void update(Typed::StateChanged event) override
+        {
+            sum += event.state;
+        }
+    };
+
+    Subject string_subject;
+    std::vector<std::shared_ptr<StringObserver>> string_observers;
+    Typed::Subject<Typed::StateChanged> typed_subject;
+    std::vector<std::shared_ptr<TypedObserver>> typed_observers;
+
+    for (int i = 0; i < observer_count; ++i)
+    {
+        string_observers.push_back(std::make_shared<StringObserver>());
+        string_subject.register_observer(string_observers.back());
+
+        typed_observers.push_back(std::make_shared<TypedObserver>());
+        typed_subject.register_observer(typed_observers.back());
     }
-};
 
-class ConcreteObserver2 : public Observer, public std::enable_shared_from_this<ConcreteObserver2>
+    int state = 0;
+
+    BENCHMARK("Subject::set_state - string events")
+    {
+        string_subject.set_state(++state);
+    };
+
+    BENCHMARK("Typed::Subject::notify - POD events")
+    {
+        typed_subject.notify(Typed::StateChanged{++state, std::chrono::steady_clock::now()});
+    };
+}
+
+TEST_CASE("SlotMap")
 {
-public:
-    void update(const std::string& event) override
+    SlotMap<std::string> slots;
+
+    auto a = slots.insert("a");
+    auto b = slots.insert("b");
+    auto c = slots.insert("c");
+
+    REQUIRE(slots.size() == 3);
+    REQUIRE(*slots.find(b) == "b");
+
+    SECTION("erase keeps values contiguous")
     {
-        std::cout << "ConcreteObserver2: " << event << std::endl;
+        REQUIRE(slots.erase(a));
+
+        REQUIRE(slots.size() == 2);
+        REQUIRE(std::vector<std::string>(slots.begin(), slots.end()) == std::vector<std::string>{"c", "b"});
+        REQUIRE(*slots.find(c) == "c");
     }
 
-    void register_me(Subject& subject)
+    SECTION("stale key does not match reused slot")
     {
-        // subject.register_observer(std::shared_ptr<Observer>(this)); // ERROR - cannot convert this to shared_ptr this way
-        subject.register_observer(shared_from_this());
+        slots.erase(b);
+        auto d = slots.insert("d");
+
+        REQUIRE(d.index == b.index);
+        REQUIRE_FALSE(slots.contains(b));
+        REQUIRE(slots.find(b) == nullptr);
+        REQUIRE_FALSE(slots.erase(b));
+        REQUIRE(*slots.find(d) == "d");
     }
-};
 
-TEST_CASE("using observer pattern")
+    SECTION("clear")
+    {
+        slots.clear();
+
+        REQUIRE(slots.empty());
+        REQUIRE_FALSE(slots.contains(a));
+        REQUIRE_FALSE(slots.contains(c));
+    }
+}
+
+namespace
 {
-    using namespace std;
+    struct ThrowingOnMove
+    {
+        inline static bool throw_on_move = false;
+
+        int value;
+
+        ThrowingOnMove(int v)
+            : value{v}
+        {
+        }
+
+        ThrowingOnMove(const ThrowingOnMove&) = default;
+        ThrowingOnMove& operator=(const ThrowingOnMove&) = default;
+
+        ThrowingOnMove(ThrowingOnMove&& other)
+            : value{other.value}
+        {
+            if (throw_on_move)
+                throw std::runtime_error{"move failed"};
+        }
+
+        ThrowingOnMove& operator=(ThrowingOnMove&&) = default;
+    };
+} // namespace
+
+TEST_CASE("SlotMap - insert is exception safe")
+{
+    SlotMap<ThrowingOnMove> slots;
+
+    auto a = slots.insert(1);
+    auto b = slots.insert(2);
+    slots.erase(a);
+
+    ThrowingOnMove::throw_on_move = true;
+    REQUIRE_THROWS_AS(slots.insert(ThrowingOnMove{3}), std::runtime_error);
+    ThrowingOnMove::throw_on_move = false;
+
+    REQUIRE(slots.size() == 1);
+    REQUIRE(slots.find(b)->value == 2);
 
+    auto c = slots.insert(3); // free slot was not lost
+    REQUIRE(c.index == a.index);
+    REQUIRE(slots.find(c)->value == 3);
+    REQUIRE(slots.erase(b));
+    REQUIRE(slots.erase(c));
+    REQUIRE(slots.empty());
+}
+
+TEST_CASE("Subject - subscriptions")
+{
     Subject s;
+    auto o1 = std::make_shared<CountingObserver>();
+    auto o2 = std::make_shared<CountingObserver>();
 
-    auto o1 = std::make_shared<ConcreteObserver1>();
-    s.register_observer(o1);
+    SECTION("observer is notified while token is alive")
+    {
+        Subscription sub1 = s.subscribe(o1);
+        {
+            Subscription sub2 = s.subscribe(o2);
+            REQUIRE(s.observer_count() == 2);
+
+            s.set_state(1);
+        }
+
+        REQUIRE(s.observer_count() == 1);
+
+        s.set_state(2);
+
+        REQUIRE(o1->updates == 2);
+        REQUIRE(o2->updates == 1);
+    }
 
+    SECTION("reset unsubscribes")
     {
-        auto o2 = std::make_shared<ConcreteObserver2>();
-        //s.register_observer(o2);
-        o2->register_me(s);
+        Subscription sub = s.subscribe(o1);
+        REQUIRE(sub.is_active());
 
+        sub.reset();
         s.set_state(1);
 
-        o2.reset();
+        REQUIRE_FALSE(sub.is_active());
+        REQUIRE(o1->updates == 0);
+    }
 
-        cout << "End of scope." << endl;
+    SECTION("moved token keeps subscription")
+    {
+        Subscription sub = s.subscribe(o1);
+        Subscription other = std::move(sub);
+
+        s.set_state(1);
+
+        REQUIRE_FALSE(sub.is_active());
+        REQUIRE(other.is_active());
+        REQUIRE(o1->updates == 1);
     }
 
-    s.set_state(2);
+    SECTION("token may outlive subject")
+    {
+        Subscription sub;
+        {
+            Subject temp;
+            sub = temp.subscribe(o1);
+        }
+
+        REQUIRE_FALSE(sub.is_active());
+    }
+
+    SECTION("observer may unsubscribe during notification")
+    {
+        struct OneShotObserver : Observer
+        {
+            Subscription subscription;
+            int updates = 0;
+
+            void update(const std::string&) override
+            {
+                ++updates;
+                subscription.reset();
+            }
+        };
+
+        auto one_shot = std::make_shared<OneShotObserver>();
+        one_shot->subscription = s.subscribe(one_shot);
+
+        s.set_state(1);
+        s.set_state(2);
+
+        REQUIRE(one_shot->updates == 1);
+    }
+}
+
+TEST_CASE("Subject registration churn - benchmark", "[.][benchmark]")
+{
+    constexpr int observer_count = 1'000;
+
+    std::vector<std::shared_ptr<CountingObserver>> observers;
+    for (int i = 0; i < observer_count; ++i)
+        observers.push_back(std::make_shared<CountingObserver>());
+
+    BENCHMARK("register_observer/unregister_observer")
+    {
+        Subject s;
+
+        for (const auto& o : observers)
+            s.register_observer(o);
+
+        for (const auto& o : observers)
+            s.unregister_observer(o);
+
+        return s.observer_count();
+    };
+
+    BENCHMARK("subscribe/Subscription::reset")
+    {
+        Subject s;
+
+        std::vector<Subscription> subscriptions;
+        subscriptions.reserve(observer_count);
+
+        for (const auto& o : observers)
+            subscriptions.push_back(s.subscribe(o));
+
+        subscriptions.clear();
+
+        return s.observer_count();
+    };
 }
@@ -0,0 +1,197 @@
+#ifndef CONCURRENT_STACK_HPP
+#define CONCURRENT_STACK_HPP
+
+#include "hazard_pointers.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// ConcurrentStack - lock-free LIFO for many producers & consumers (Treiber stack)
+//
+// Nodes removed by pop are reclaimed with hazard pointers - the pointer compared by CAS
+// is protected, so it cannot be freed & reused in the meantime (no ABA).
+// When CAS on the head fails (contention), push and pop try to meet in the elimination
+// array: a push offers its node in a random slot for a moment and a pop may take it
+// without touching the head at all.
+
+template <typename T>
+class ConcurrentStack
+{
+    struct Node
+    {
+        T value;
+        Node* next = nullptr;
+
+        template <typename... TArgs>
+        explicit Node(TArgs&&... args)
+            : value(std::forward<TArgs>(args)...)
+        {
+        }
+    };
+
+    static constexpr size_t elimination_slots = 16;
+    static constexpr int elimination_spins = 64;
+
+    struct alignas(64) EliminationSlot
+    {
+        std::atomic<Node*> node{nullptr};
+    };
+
+    alignas(64) std::atomic<Node*> head_{nullptr};
+    std::array<EliminationSlot, elimination_slots> elimination_;
+
+    static inline char taken_marker_;
+
+    // marks a slot whose node was taken by pop - never dereferenced
+    static Node* taken() noexcept
+    {
+        return reinterpret_cast<Node*>(&taken_marker_);
+    }
+
+public:
+    using value_type = T;
+
+    ConcurrentStack() = default;
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    // no other thread may use the stack during destruction
+    ~ConcurrentStack()
+    {
+        Node* node = head_.load(std::memory_order_acquire);
+
+        while (node)
+            delete std::exchange(node, node->next);
+    }
+
+    // snapshot - may be outdated immediately
+    bool empty() const noexcept
+    {
+        return head_.load(std::memory_order_acquire) == nullptr;
+    }
+
+    void push(const T& item)
+    {
+        push_node(new Node(item));
+    }
+
+    void push(T&& item)
+    {
+        push_node(new Node(std::move(item)));
+    }
+
+    template <typename... TArgs>
+    void emplace(TArgs&&... args)
+    {
+        push_node(new Node(std::forward<TArgs>(args)...));
+    }
+
+    std::optional<T> try_pop()
+    {
+        HazardPointers::Guard guard;
+
+        while (true)
+        {
+            Node* old_head = guard.protect(head_);
+
+            if (!old_head)
+                return std::nullopt;
+
+            if (head_.compare_exchange_strong(old_head, old_head->next, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                guard.reset();
+
+                std::optional<T> item{std::move(old_head->value)};
+                HazardPointers::retire(old_head);
+
+                return item;
+            }
+
+            if (Node* node = take_eliminated())
+            {
+                std::optional<T> item{std::move(node->value)};
+                delete node; // offered node was never linked - no thread can reference it
+
+                return item;
+            }
+        }
+    }
+
+    bool try_pop(T& item)
+    {
+        std::optional<T> popped = try_pop();
+
+        if (!popped)
+            return false;
+
+        item = std::move(*popped);
+        return true;
+    }
+
+private:
+    void push_node(Node* node) noexcept
+    {
+        node->next = head_.load(std::memory_order_relaxed);
+
+        while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+            if (offer_for_elimination(node))
+                return;
+        }
+    }
+
+    static size_t random_slot() noexcept
+    {
+        thread_local uint32_t state = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        return state % elimination_slots;
+    }
+
+    // returns true if the node was taken by a concurrent pop
+    bool offer_for_elimination(Node* node) noexcept
+    {
+        std::atomic<Node*>& slot = elimination_[random_slot()].node;
+
+        Node* expected = nullptr;
+        if (!slot.compare_exchange_strong(expected, node, std::memory_order_release, std::memory_order_relaxed))
+            return false;
+
+        for (int i = 0; i < elimination_spins && slot.load(std::memory_order_relaxed) == node; ++i)
+            std::this_thread::yield();
+
+        expected = node;
+        if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed))
+            return false; // offer withdrawn
+
+        slot.store(nullptr, std::memory_order_release); // slot marked as taken - the pushing thread frees it
+        return true;
+    }
+
+    Node* take_eliminated() noexcept
+    {
+        std::atomic<Node*>& slot = elimination_[random_slot()].node;
+
+        Node* offered = slot.load(std::memory_order_relaxed);
+        if (!offered || offered == taken())
+            return nullptr;
+
+        if (slot.compare_exchange_strong(offered, taken(), std::memory_order_acquire, std::memory_order_relaxed))
+            return offered;
+
+        return nullptr;
+    }
+};
+
+#endif // CONCURRENT_STACK_HPP
@@ -0,0 +1,218 @@
+#ifndef HAZARD_POINTERS_HPP
+#define HAZARD_POINTERS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// HazardPointers - safe memory reclamation for lock-free data structures
+//
+// A thread publishes the pointer it is about to dereference in its hazard slot.
+// Removed nodes are retired instead of deleted - they are deleted by scan() only when
+// no hazard slot points to them. A node cannot be freed and reused while it is protected,
+// so a CAS comparing protected pointers is also free of the ABA problem.
+
+namespace HazardPointers
+{
+    inline constexpr size_t max_threads = 128;
+
+    namespace Detail
+    {
+        struct alignas(64) Slot
+        {
+            std::atomic<std::thread::id> owner{};
+            std::atomic<const void*> pointer{nullptr};
+        };
+
+        struct Retired
+        {
+            void* ptr;
+            void (*deleter)(void*);
+        };
+
+        // process-wide table of slots & nodes left by finished threads
+        class Domain
+        {
+            Slot slots_[max_threads];
+            std::mutex orphans_mtx_;
+            std::vector<Retired> orphans_;
+
+        public:
+            static Domain& instance()
+            {
+                static Domain domain;
+                return domain;
+            }
+
+            ~Domain()
+            {
+                for (const Retired& r : orphans_)
+                    r.deleter(r.ptr);
+            }
+
+            Slot& acquire_slot()
+            {
+                const std::thread::id this_id = std::this_thread::get_id();
+
+                for (Slot& slot : slots_)
+                {
+                    std::thread::id free_id{};
+                    if (slot.owner.compare_exchange_strong(free_id, this_id))
+                        return slot;
+                }
+
+                throw std::runtime_error("No free hazard pointer slots");
+            }
+
+            void release_slot(Slot& slot) noexcept
+            {
+                slot.pointer.store(nullptr, std::memory_order_release);
+                slot.owner.store(std::thread::id{}, std::memory_order_release);
+            }
+
+            void collect_hazards(std::vector<const void*>& hazards) const
+            {
+                hazards.clear();
+
+                for (const Slot& slot : slots_)
+                {
+                    if (const void* ptr = slot.pointer.load(std::memory_order_seq_cst))
+                        hazards.push_back(ptr);
+                }
+
+                std::sort(hazards.begin(), hazards.end());
+            }
+
+            void adopt(std::vector<Retired>& retired)
+            {
+                std::lock_guard lk{orphans_mtx_};
+                orphans_.insert(orphans_.end(), retired.begin(), retired.end());
+                retired.clear();
+            }
+
+            void take_orphans(std::vector<Retired>& retired)
+            {
+                std::lock_guard lk{orphans_mtx_};
+                retired.insert(retired.end(), orphans_.begin(), orphans_.end());
+                orphans_.clear();
+            }
+        };
+
+        // hazard slot & retired nodes of the current thread
+        class ThreadRecord
+        {
+            static constexpr size_t scan_threshold = 2 * max_threads;
+
+            Domain& domain_ = Domain::instance();
+            Slot* slot_ = nullptr;
+            std::vector<Retired> retired_;
+            std::vector<const void*> hazards_;
+
+        public:
+            static ThreadRecord& instance()
+            {
+                thread_local ThreadRecord record;
+                return record;
+            }
+
+            ~ThreadRecord()
+            {
+                if (slot_)
+                    domain_.release_slot(*slot_);
+
+                scan();
+
+                if (!retired_.empty())
+                    domain_.adopt(retired_);
+            }
+
+            std::atomic<const void*>& hazard()
+            {
+                if (!slot_)
+                    slot_ = &domain_.acquire_slot();
+
+                return slot_->pointer;
+            }
+
+            void retire(void* ptr, void (*deleter)(void*))
+            {
+                retired_.push_back(Retired{ptr, deleter});
+
+                if (retired_.size() >= scan_threshold)
+                    scan();
+            }
+
+            void scan()
+            {
+                domain_.take_orphans(retired_);
+                domain_.collect_hazards(hazards_);
+
+                auto still_protected = std::partition(retired_.begin(), retired_.end(), [this](const Retired& r) {
+                    return std::binary_search(hazards_.begin(), hazards_.end(), r.ptr);
+                });
+
+                for (auto it = still_protected; it != retired_.end(); ++it)
+                    it->deleter(it->ptr);
+
+                retired_.erase(still_protected, retired_.end());
+            }
+        };
+    } // namespace Detail
+
+    // Guard - hazard slot of the current thread, cleared on destruction
+    class Guard
+    {
+        std::atomic<const void*>& hazard_;
+
+    public:
+        Guard()
+            : hazard_{Detail::ThreadRecord::instance().hazard()}
+        {
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard()
+        {
+            reset();
+        }
+
+        // returns a value of src that stays valid until reset() or destruction
+        template <typename T>
+        T* protect(const std::atomic<T*>& src) noexcept
+        {
+            T* ptr = src.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                hazard_.store(ptr, std::memory_order_seq_cst);
+
+                T* current = src.load(std::memory_order_seq_cst);
+                if (current == ptr)
+                    return ptr;
+
+                ptr = current;
+            }
+        }
+
+        void reset() noexcept
+        {
+            hazard_.store(nullptr, std::memory_order_release);
+        }
+    };
+
+    // ptr is deleted when no thread protects it
+    template <typename T>
+    void retire(T* ptr)
+    {
+        Detail::ThreadRecord::instance().retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+} // namespace HazardPointers
+
+#endif // HAZARD_POINTERS_HPP
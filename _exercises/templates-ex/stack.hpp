@@ -0,0 +1,125 @@
+#ifndef STACK_HPP
+#define STACK_HPP
+
+#include "stack_storage.hpp"
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////
+// Stack - LIFO container with pluggable allocator & backing store
+//
+// Items are stored in StoragePolicy::type<T, Allocator> (std::vector by default) -
+// allocator propagation on copy/move/swap follows std::allocator_traits of Allocator.
+
+template <typename T, typename Allocator = std::allocator<T>, typename StoragePolicy = StackStorage::Contiguous>
+class Stack
+{
+    using Storage = typename StoragePolicy::template type<T, Allocator>;
+
+    static constexpr bool uses_allocator = std::is_constructible_v<Storage, const Allocator&>;
+
+    Storage items_;
+
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using allocator_type = Allocator;
+
+    Stack() = default;
+
+    explicit Stack(const std::type_identity_t<Allocator>& alloc) noexcept
+        requires uses_allocator
+        : items_(alloc)
+    { }
+
+    Stack(const Stack& other, const std::type_identity_t<Allocator>& alloc)
+        requires uses_allocator
+        : items_(other.items_, alloc)
+    { }
+
+    Stack(Stack&& other, const std::type_identity_t<Allocator>& alloc)
+        requires uses_allocator
+        : items_(std::move(other.items_), alloc)
+    { }
+
+    allocator_type get_allocator() const noexcept
+        requires uses_allocator
+    {
+        return items_.get_allocator();
+    }
+
+    bool empty() const noexcept
+    {
+        return items_.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return items_.size();
+    }
+
+    void push(const T& item)
+    {
+        items_.emplace_back(item);
+    }
+
+    void push(T&& item)
+    {
+        items_.emplace_back(std::move(item));
+    }
+
+    template <typename... TArgs>
+    reference emplace(TArgs&&... args)
+    {
+        return items_.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    reference top()
+    {
+        return items_.back();
+    }
+
+    const_reference top() const
+    {
+        return items_.back();
+    }
+
+    // returns the popped item when it can be moved out without breaking exception safety
+    auto pop() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if constexpr (std::is_nothrow_move_constructible_v<T>)
+        {
+            T item = std::move(items_.back());
+            items_.pop_back();
+            return item;
+        }
+        else
+        {
+            items_.pop_back();
+        }
+    }
+
+    void swap(Stack& other) noexcept(noexcept(items_.swap(other.items_)))
+    {
+        items_.swap(other.items_);
+    }
+};
+
+template <typename T, size_t ChunkSize = 256, typename Allocator = std::allocator<T>>
+using SegmentedStack = Stack<T, Allocator, StackStorage::Segmented<ChunkSize>>;
+
+template <typename T, size_t Capacity>
+using InlineStack = Stack<T, std::allocator<T>, StackStorage::Inline<Capacity>>;
+
+namespace pmr
+{
+    template <typename T, typename StoragePolicy = StackStorage::Contiguous>
+    using Stack = ::Stack<T, std::pmr::polymorphic_allocator<T>, StoragePolicy>;
+}
+
+#endif // STACK_HPP
@@ -0,0 +1,478 @@
+#ifndef STACK_STORAGE_HPP
+#define STACK_STORAGE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+// backing stores for Stack
+//
+// Every store provides: empty, size, emplace_back, back, pop_back, clear, swap.
+// Stores using an allocator are constructible from it and provide get_allocator.
+
+// SegmentedBuffer - chunks of ChunkSize items, items are never relocated
+//
+// Chunks are kept after popping (like capacity of std::vector), so pushing and popping
+// around a chunk boundary does not allocate. shrink_to_fit() releases unused chunks.
+template <typename T, typename Allocator, size_t ChunkSize>
+class SegmentedBuffer
+{
+    static_assert(ChunkSize > 0);
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using ChunkList = std::vector<T*, typename AllocTraits::template rebind_alloc<T*>>;
+
+    [[no_unique_address]] Allocator alloc_;
+    ChunkList chunks_;
+    size_t size_ = 0;
+    size_t chunk_index_ = 0; // chunk holding the top item
+    T* next_ = nullptr;      // place for the next item in the current chunk
+    T* chunk_begin_ = nullptr;
+    T* chunk_end_ = nullptr;
+
+public:
+    using allocator_type = Allocator;
+
+    static constexpr size_t chunk_size = ChunkSize;
+
+    SegmentedBuffer() noexcept(noexcept(Allocator()))
+        : SegmentedBuffer(Allocator())
+    {
+    }
+
+    explicit SegmentedBuffer(const Allocator& alloc) noexcept
+        : alloc_{alloc}
+        , chunks_(alloc)
+    {
+    }
+
+    SegmentedBuffer(const SegmentedBuffer& other)
+        : SegmentedBuffer(other, AllocTraits::select_on_container_copy_construction(other.alloc_))
+    {
+    }
+
+    SegmentedBuffer(const SegmentedBuffer& other, const Allocator& alloc)
+        : SegmentedBuffer(alloc)
+    {
+        try
+        {
+            other.for_each_bottom_up([this](const T& item) { emplace_back(item); });
+        }
+        catch (...)
+        {
+            destroy_all();
+            throw;
+        }
+    }
+
+    SegmentedBuffer(SegmentedBuffer&& other) noexcept
+        : alloc_{std::move(other.alloc_)}
+        , chunks_(std::move(other.chunks_))
+        , size_{std::exchange(other.size_, 0)}
+        , chunk_index_{std::exchange(other.chunk_index_, 0)}
+        , next_{std::exchange(other.next_, nullptr)}
+        , chunk_begin_{std::exchange(other.chunk_begin_, nullptr)}
+        , chunk_end_{std::exchange(other.chunk_end_, nullptr)}
+    {
+        other.chunks_.clear();
+    }
+
+    SegmentedBuffer(SegmentedBuffer&& other, const Allocator& alloc)
+        : SegmentedBuffer(alloc)
+    {
+        if (alloc_ == other.alloc_)
+        {
+            steal(other);
+            return;
+        }
+
+        try
+        {
+            other.for_each_bottom_up([this](T& item) { emplace_back(std::move(item)); });
+        }
+        catch (...)
+        {
+            destroy_all();
+            throw;
+        }
+    }
+
+    SegmentedBuffer& operator=(const SegmentedBuffer& other)
+    {
+        if (this != &other)
+        {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+            {
+                if (alloc_ != other.alloc_)
+                {
+                    destroy_all();
+                    alloc_ = other.alloc_;
+                    chunks_ = ChunkList(alloc_);
+                }
+            }
+
+            clear();
+            other.for_each_bottom_up([this](const T& item) { emplace_back(item); });
+        }
+
+        return *this;
+    }
+
+    SegmentedBuffer& operator=(SegmentedBuffer&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+        {
+            destroy_all();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        }
+        else
+        {
+            if (alloc_ == other.alloc_)
+            {
+                destroy_all();
+                steal(other);
+            }
+            else
+            {
+                clear();
+                other.for_each_bottom_up([this](T& item) { emplace_back(std::move(item)); });
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    ~SegmentedBuffer()
+    {
+        destroy_all();
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return chunks_.size() * ChunkSize;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (next_ == chunk_end_) [[unlikely]]
+            return emplace_in_next_chunk(std::forward<TArgs>(args)...);
+
+        AllocTraits::construct(alloc_, next_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *next_++;
+    }
+
+    T& back() noexcept
+    {
+        assert(!empty());
+        return *(next_ - 1);
+    }
+
+    const T& back() const noexcept
+    {
+        assert(!empty());
+        return *(next_ - 1);
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty());
+
+        AllocTraits::destroy(alloc_, --next_);
+        --size_;
+
+        // top item must be in the current chunk
+        if (next_ == chunk_begin_ && chunk_index_ != 0) [[unlikely]]
+            enter_chunk(chunk_index_ - 1, ChunkSize);
+    }
+
+    void clear() noexcept
+    {
+        while (!empty())
+            pop_back();
+    }
+
+    // releases chunks above the current one
+    void shrink_to_fit() noexcept
+    {
+        const size_t used_chunks = empty() ? 0 : chunk_index_ + 1;
+
+        while (chunks_.size() > used_chunks)
+        {
+            AllocTraits::deallocate(alloc_, chunks_.back(), ChunkSize);
+            chunks_.pop_back();
+        }
+
+        if (chunks_.empty())
+            next_ = chunk_begin_ = chunk_end_ = nullptr;
+    }
+
+    void swap(SegmentedBuffer& other) noexcept
+    {
+        using std::swap;
+
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+            swap(alloc_, other.alloc_);
+        else
+            assert(alloc_ == other.alloc_);
+
+        swap(chunks_, other.chunks_);
+        swap(size_, other.size_);
+        swap(chunk_index_, other.chunk_index_);
+        swap(next_, other.next_);
+        swap(chunk_begin_, other.chunk_begin_);
+        swap(chunk_end_, other.chunk_end_);
+    }
+
+private:
+    template <typename F>
+    void for_each_bottom_up(F f) const
+    {
+        for (size_t i = 0, remaining = size_; remaining != 0; ++i)
+        {
+            const size_t count = std::min(remaining, ChunkSize);
+
+            for (T* item = chunks_[i]; item != chunks_[i] + count; ++item)
+                f(*item);
+
+            remaining -= count;
+        }
+    }
+
+    template <typename... TArgs>
+    T& emplace_in_next_chunk(TArgs&&... args)
+    {
+        const size_t index = (size_ == 0) ? 0 : chunk_index_ + 1;
+
+        if (index == chunks_.size())
+        {
+            // list of chunks grows geometrically - push_back below cannot throw after the chunk is allocated
+            if (chunks_.size() == chunks_.capacity())
+                chunks_.reserve(std::max<size_t>(1, 2 * chunks_.size()));
+            chunks_.push_back(AllocTraits::allocate(alloc_, ChunkSize));
+        }
+
+        // on exception the new chunk stays as a spare one
+        AllocTraits::construct(alloc_, chunks_[index], std::forward<TArgs>(args)...);
+
+        enter_chunk(index, 1);
+        ++size_;
+
+        return *chunk_begin_;
+    }
+
+    void enter_chunk(size_t index, size_t item_count) noexcept
+    {
+        chunk_index_ = index;
+        chunk_begin_ = chunks_[index];
+        chunk_end_ = chunk_begin_ + ChunkSize;
+        next_ = chunk_begin_ + item_count;
+    }
+
+    void steal(SegmentedBuffer& other) noexcept
+    {
+        chunks_ = std::move(other.chunks_);
+        other.chunks_.clear();
+        size_ = std::exchange(other.size_, 0);
+        chunk_index_ = std::exchange(other.chunk_index_, 0);
+        next_ = std::exchange(other.next_, nullptr);
+        chunk_begin_ = std::exchange(other.chunk_begin_, nullptr);
+        chunk_end_ = std::exchange(other.chunk_end_, nullptr);
+    }
+
+    void destroy_all() noexcept
+    {
+        clear();
+
+        for (T* chunk : chunks_)
+            AllocTraits::deallocate(alloc_, chunk, ChunkSize);
+
+        chunks_.clear();
+        chunk_index_ = 0;
+        next_ = chunk_begin_ = chunk_end_ = nullptr;
+    }
+};
+
+// InlineBuffer - fixed capacity, items are stored inside the object (no allocations)
+//
+// Pushing into a full buffer throws std::length_error.
+template <typename T, size_t Capacity>
+class InlineBuffer
+{
+    alignas(T) std::byte storage_[Capacity * sizeof(T)];
+    size_t size_ = 0;
+
+    T* data() noexcept
+    {
+        return reinterpret_cast<T*>(storage_);
+    }
+
+    const T* data() const noexcept
+    {
+        return reinterpret_cast<const T*>(storage_);
+    }
+
+public:
+    static constexpr size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+
+    InlineBuffer() noexcept = default;
+
+    InlineBuffer(const InlineBuffer& other)
+    {
+        std::uninitialized_copy_n(other.data(), other.size_, data());
+        size_ = other.size_;
+    }
+
+    InlineBuffer(InlineBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        std::uninitialized_move_n(other.data(), other.size_, data());
+        size_ = other.size_;
+        other.clear();
+    }
+
+    InlineBuffer& operator=(const InlineBuffer& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            std::uninitialized_copy_n(other.data(), other.size_, data());
+            size_ = other.size_;
+        }
+
+        return *this;
+    }
+
+    InlineBuffer& operator=(InlineBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            std::uninitialized_move_n(other.data(), other.size_, data());
+            size_ = other.size_;
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~InlineBuffer()
+    {
+        clear();
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == Capacity) [[unlikely]]
+            throw std::length_error("InlineBuffer capacity exceeded");
+
+        T* item = std::construct_at(data() + size_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    T& back() noexcept
+    {
+        assert(!empty());
+        return data()[size_ - 1];
+    }
+
+    const T& back() const noexcept
+    {
+        assert(!empty());
+        return data()[size_ - 1];
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty());
+        std::destroy_at(data() + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(data(), size_);
+        size_ = 0;
+    }
+
+    void swap(InlineBuffer& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        InlineBuffer temp{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////
+// storage policies for Stack
+
+namespace StackStorage
+{
+    // Contiguous - growable buffer (std::vector), the fastest for most workloads
+    struct Contiguous
+    {
+        template <typename T, typename Allocator>
+        using type = std::vector<T, Allocator>;
+    };
+
+    // Segmented - chunk list, no relocation of items on growth (stable references)
+    template <size_t ChunkSize = 256>
+    struct Segmented
+    {
+        template <typename T, typename Allocator>
+        using type = SegmentedBuffer<T, Allocator, ChunkSize>;
+    };
+
+    // Inline - fixed capacity array inside the stack object, allocator is not used
+    template <size_t Capacity>
+    struct Inline
+    {
+        template <typename T, typename Allocator>
+        using type = InlineBuffer<T, Capacity>;
+    };
+} // namespace StackStorage
+
+#endif // STACK_STORAGE_HPP
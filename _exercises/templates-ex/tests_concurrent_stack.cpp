@@ -0,0 +1,154 @@
+#include "concurrent_stack.hpp"
+#include "stack.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ConcurrentStack - single thread", "[stack,concurrent]")
+{
+    ConcurrentStack<std::unique_ptr<std::string>> s;
+
+    REQUIRE(s.empty());
+    REQUIRE(s.try_pop() == std::nullopt);
+
+    s.push(std::make_unique<std::string>("txt1"));
+    s.emplace(new std::string("txt2"));
+
+    REQUIRE_FALSE(s.empty());
+    REQUIRE(**s.try_pop() == "txt2");
+
+    std::unique_ptr<std::string> item;
+    REQUIRE(s.try_pop(item));
+    REQUIRE(*item == "txt1");
+    REQUIRE_FALSE(s.try_pop(item));
+}
+
+TEST_CASE("ConcurrentStack - stress", "[stack,concurrent]")
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int items_per_producer = 50'000;
+    constexpr int total = producers * items_per_producer;
+
+    ConcurrentStack<int> s;
+    std::vector<std::atomic<int>> pop_counts(total);
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&s, p] {
+            for (int i = 0; i < items_per_producer; ++i)
+                s.push(p * items_per_producer + i);
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while (popped.load() < total)
+            {
+                if (std::optional<int> item = s.try_pop())
+                {
+                    pop_counts[*item].fetch_add(1);
+                    popped.fetch_add(1);
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for (auto& thd : threads)
+        thd.join();
+
+    REQUIRE(s.empty());
+    REQUIRE(std::all_of(pop_counts.begin(), pop_counts.end(), [](const auto& count) { return count.load() == 1; }));
+}
+
+namespace
+{
+    // reference implementation - Stack guarded by a mutex
+    template <typename T>
+    class MutexStack
+    {
+        std::mutex mtx_;
+        Stack<T> items_;
+
+    public:
+        void push(T item)
+        {
+            std::lock_guard lk{mtx_};
+            items_.push(std::move(item));
+        }
+
+        std::optional<T> try_pop()
+        {
+            std::lock_guard lk{mtx_};
+
+            if (items_.empty())
+                return std::nullopt;
+
+            return items_.pop();
+        }
+    };
+
+    template <typename StackType>
+    int push_pop_in_threads(StackType& s, int thread_count, int operations)
+    {
+        std::atomic<int> checksum{0};
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&s, &checksum, operations, thread_count] {
+                int local_sum = 0;
+
+                for (int i = 0; i < operations / thread_count; ++i)
+                {
+                    s.push(i);
+                    if (std::optional<int> item = s.try_pop())
+                        local_sum += *item;
+                }
+
+                checksum += local_sum;
+            });
+        }
+
+        for (auto& thd : threads)
+            thd.join();
+
+        return checksum;
+    }
+} // namespace
+
+TEST_CASE("ConcurrentStack vs. mutex - benchmark", "[.][benchmark]")
+{
+    constexpr int operations = 256'000;
+
+    for (int thread_count : {1, 2, 4, 8, 16, 32, 64})
+    {
+        const std::string threads = " - " + std::to_string(thread_count) + " threads";
+
+        BENCHMARK("ConcurrentStack" + threads)
+        {
+            ConcurrentStack<int> s;
+            return push_pop_in_threads(s, thread_count, operations);
+        };
+
+        BENCHMARK("MutexStack" + threads)
+        {
+            MutexStack<int> s;
+            return push_pop_in_threads(s, thread_count, operations);
+        };
+    }
+}
@@ -1,167 +1,447 @@
+#include "memory_resources.hpp"
+#include "stack.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <algorithm>
 #include <array>
+#include <deque>
 #include <memory>
+#include <memory_resource>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("After construction", "[stack,constructors]")
+{
+    Stack<int> s;
+
+    SECTION("is empty")
+    {
+        REQUIRE(s.empty());
+    }
+
+    SECTION("size is zero")
+    {
+        REQUIRE(s.size() == 0);
+    }
+}
+
+TEST_CASE("Pushing an item", "[stack,push]")
+{
+    Stack<int> s;
+
+    SECTION("is no longer empty")
+    {
+        s.push(1);
+
+        REQUIRE(!s.empty());
+    }
+
+    SECTION("size is increased")
+    {
+        auto size_before = s.size();
+
+        s.push(1);
+
+        REQUIRE(s.size() - size_before == 1);
+    }
+
+    SECTION("recently pushed item is on a top")
+    {
+        s.push(4);
+
+        REQUIRE(s.top() == 4);
+    }
+}
+
+template <typename T>
+std::vector<T> pop_all(Stack<T>& s)
+{
+    std::vector<T> values(s.size());
+
+    for (auto& item : values)
+    {
+        item = std::move(s.top());
+        s.pop();
+    }
+
+    return values;
+}
+
+TEST_CASE("Popping an item", "[stack,pop]")
+{
+    Stack<int> s;
+
+    s.push(1);
+    s.push(4);
+
+    int item;
+
+    SECTION("assignes an item from a top to an argument passed by ref")
+    {
+        item = s.top();
+        s.pop();
 
-// TEST_CASE("After construction", "[stack,constructors]")
-// {
-//     Stack<int> s;
+        REQUIRE(item == 4);
+    }
 
-//     SECTION("is empty")
-//     {
-//         REQUIRE(s.empty());
-//     }
+    SECTION("size is decreased")
+    {
+        size_t size_before = s.size();
 
-//     SECTION("size is zero")
-//     {
-//         REQUIRE(s.size() == 0);
-//     }
-// }
+        item = s.top();
+        s.pop();
 
-// TEST_CASE("Pushing an item", "[stack,push]")
-// {
-//     Stack<int> s;
 
-//     SECTION("is no longer empty")
-//     {
-//         s.push(1);
+        REQUIRE(size_before - s.size() == 1);
+    }
 
-//         REQUIRE(!s.empty());
-//     }
+    SECTION("LIFO order")
+    {
+        int a, b;
 
-//     SECTION("size is increased")
-//     {
-//         auto size_before = s.size();
+        a = s.top();
+        s.pop();
 
-//         s.push(1);
+        b = s.top();
+        s.pop();
 
-//         REQUIRE(s.size() - size_before == 1);
-//     }
 
-//     SECTION("recently pushed item is on a top")
-//     {
-//         s.push(4);
+        REQUIRE(a == 4);
+        REQUIRE(b == 1);
+    }
+}
 
-//         REQUIRE(s.top() == 4);
-//     }
-// }
+TEST_CASE("Move semantics", "[stack,push,pop,move]")
+{
+    using namespace std::literals;
 
-// template <typename T>
-// std::vector<T> pop_all(Stack<T>& s)
-// {
-//     std::vector<T> values(s.size());
+    SECTION("stores move-only objects")
+    {
+        auto txt1 = std::make_unique<std::string>("test1");
 
-//     for (auto& item : values)
-//     {
-//         item = std::move(s.top());
-//         s.pop();
-//     }
+        Stack<std::unique_ptr<std::string>> s;
 
-//     return values;
-// }
+        s.push(move(txt1));
+        s.push(std::make_unique<std::string>("test2"));
 
-// TEST_CASE("Popping an item", "[stack,pop]")
-// {
-//     Stack<int> s;
+        std::unique_ptr<std::string> value;
 
-//     s.push(1);
-//     s.push(4);
+        value = std::move(s.top());
+        s.pop();
+        REQUIRE(*value == "test2"s);
 
-//     int item;
+        value = std::move(s.top());
+        s.pop();
+        REQUIRE(*value == "test1"s);
+    }
 
-//     SECTION("assignes an item from a top to an argument passed by ref")
-//     {
-//         item = s.top();
-//         s.pop();
+    SECTION("move constructor", "[stack,move]")
+    {
+        Stack<std::unique_ptr<std::string>> s;
 
-//         REQUIRE(item == 4);
-//     }
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
 
-//     SECTION("size is decreased")
-//     {
-//         size_t size_before = s.size();
+        auto moved_s = std::move(s);
 
-//         item = s.top();
-//         s.pop();
+        auto values = pop_all(moved_s);
 
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
 
-//         REQUIRE(size_before - s.size() == 1);
-//     }
+    SECTION("move assignment", "[stack,move]")
+    {
+        Stack<std::unique_ptr<std::string>> s;
 
-//     SECTION("LIFO order")
-//     {
-//         int a, b;
+        s.push(std::make_unique<std::string>("txt1"));
+        s.push(std::make_unique<std::string>("txt2"));
+        s.push(std::make_unique<std::string>("txt3"));
 
-//         a = s.top();
-//         s.pop();
+        Stack<std::unique_ptr<std::string>> target;
+        target.push(std::make_unique<std::string>("x"));
 
-//         b = s.top();
-//         s.pop();
+        target = std::move(s);
 
+        REQUIRE(target.size() == 3);
 
-//         REQUIRE(a == 4);
-//         REQUIRE(b == 1);
-//     }
-// }
+        auto values = pop_all(target);
 
-// TEST_CASE("Move semantics", "[stack,push,pop,move]")
-// {
-//     using namespace std::literals;
+        auto expected = {"txt3", "txt2", "txt1"};
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
+    }
+}
 
-//     SECTION("stores move-only objects")
-//     {
-//         auto txt1 = std::make_unique<std::string>("test1");
+TEST_CASE("Memory resources", "[stack,pmr]")
+{
+    std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
 
-//         Stack<std::unique_ptr<std::string>> s;
+    SECTION("items are allocated in given resource")
+    {
+        pmr::Stack<std::pmr::string> s{&arena};
 
-//         s.push(move(txt1));
-//         s.push(std::make_unique<std::string>("test2"));
+        s.push("a text long enough to be allocated on heap by std::string");
+        s.emplace(64, 'x');
 
-//         std::unique_ptr<std::string> value;
+        REQUIRE(s.get_allocator().resource() == &arena);
+        REQUIRE(s.top().get_allocator().resource() == &arena);
+    }
 
-//         value = std::move(s.top());
-//         s.pop();
-//         REQUIRE(*value == "test2"s);
+    SECTION("resource is not propagated on move assignment")
+    {
+        pmr::Stack<int> s;
+        s.push(1);
+        s.push(2);
 
-//         value = std::move(s.top());
-//         s.pop();
-//         REQUIRE(*value == "test1"s);
-//     }
+        pmr::Stack<int> target{&arena};
+        target = std::move(s);
 
-//     SECTION("move constructor", "[stack,move]")
-//     {
-//         Stack<std::unique_ptr<std::string>> s;
+        REQUIRE(target.get_allocator().resource() == &arena);
+        REQUIRE(target.size() == 2);
+        REQUIRE(target.top() == 2);
+    }
 
-//         s.push(std::make_unique<std::string>("txt1"));
-//         s.push(std::make_unique<std::string>("txt2"));
-//         s.push(std::make_unique<std::string>("txt3"));
+    SECTION("pool resource reuses memory of popped items")
+    {
+        Helpers::PoolResource pool;
+        pmr::Stack<std::pmr::string> s{&pool};
 
-//         auto moved_s = std::move(s);
+        for (int i = 0; i < 10; ++i)
+            s.emplace(100, 'x');
+        while (!s.empty())
+            s.pop();
 
-//         auto values = pop_all(moved_s);
+        REQUIRE(pool.stats().peak_bytes_used > 0);
+        REQUIRE(pool.stats().bytes_used < pool.stats().peak_bytes_used);
+    }
+}
 
-//         auto expected = {"txt3", "txt2", "txt1"};
-//         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
-//     }
+TEMPLATE_TEST_CASE("Backing stores", "[stack,storage]", (Stack<std::string>), (SegmentedStack<std::string, 4>), (InlineStack<std::string, 64>))
+{
+    using StackType = TestType;
 
-//     SECTION("move assignment", "[stack,move]")
-//     {
-//         Stack<std::unique_ptr<std::string>> s;
+    StackType s;
 
-//         s.push(std::make_unique<std::string>("txt1"));
-//         s.push(std::make_unique<std::string>("txt2"));
-//         s.push(std::make_unique<std::string>("txt3"));
+    for (int i = 0; i < 10; ++i)
+        s.emplace(std::to_string(i));
 
-//         Stack<std::unique_ptr<std::string>> target;
-//         target.push(std::make_unique<std::string>("x"));
+    SECTION("LIFO order across chunk boundaries")
+    {
+        REQUIRE(s.size() == 10);
 
-//         target = std::move(s);
+        for (int i = 9; i >= 0; --i)
+            REQUIRE(s.pop() == std::to_string(i));
 
-//         REQUIRE(target.size() == 3);
+        REQUIRE(s.empty());
+    }
 
-//         auto values = pop_all(target);
+    SECTION("push after pop reuses storage")
+    {
+        for (int i = 0; i < 5; ++i)
+            s.pop();
+        s.push("x");
 
-//         auto expected = {"txt3", "txt2", "txt1"};
-//         REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), [](const auto& a, const auto& b) { return *a == b; }));
-//     }
-// }
\ No newline at end of file
+        REQUIRE(s.size() == 6);
+        REQUIRE(s.top() == "x");
+        s.pop();
+        REQUIRE(s.top() == "4");
+    }
+
+    SECTION("copy")
+    {
+        StackType copy = s;
+
+        REQUIRE(copy.size() == 10);
+        REQUIRE(copy.pop() == "9");
+        REQUIRE(s.top() == "9");
+    }
+
+    SECTION("move & swap")
+    {
+        StackType target;
+        target.push("a");
+
+        target = std::move(s);
+        REQUIRE(target.size() == 10);
+        REQUIRE(target.top() == "9");
+
+        StackType other;
+        other.push("b");
+        other.swap(target);
+
+        REQUIRE(other.size() == 10);
+        REQUIRE(target.top() == "b");
+    }
+}
+
+TEST_CASE("Segmented stack", "[stack,storage]")
+{
+    SECTION("items are never relocated")
+    {
+        SegmentedStack<int, 4> s;
+
+        s.push(0);
+        const int* bottom = &s.top();
+
+        for (int i = 1; i < 100; ++i)
+            s.push(i);
+        while (s.size() > 1)
+            s.pop();
+
+        REQUIRE(&s.top() == bottom);
+        REQUIRE(*bottom == 0);
+    }
+
+    SECTION("items in other memory resource")
+    {
+        Helpers::PoolResource pool;
+        pmr::Stack<int, StackStorage::Segmented<4>> pmr_stack{&pool};
+
+        for (int i = 0; i < 100; ++i)
+            pmr_stack.push(i);
+
+        REQUIRE(pool.stats().bytes_used >= 100 * sizeof(int));
+        REQUIRE(pmr_stack.top() == 99);
+    }
+
+    SECTION("list of chunks grows geometrically")
+    {
+        constexpr size_t chunk_count = 1024;
+
+        Helpers::ArenaResource arena; // memory of reallocated chunk lists is never reclaimed
+        pmr::Stack<int, StackStorage::Segmented<1>> pmr_stack{&arena};
+
+        for (size_t i = 0; i < chunk_count; ++i)
+            pmr_stack.push(static_cast<int>(i));
+
+        // growing by one slot would leave ~chunk_count^2 / 2 pointers behind
+        REQUIRE(arena.stats().bytes_used < 8 * chunk_count * (sizeof(int*) + sizeof(int)));
+    }
+}
+
+TEST_CASE("Inline stack", "[stack,storage]")
+{
+    InlineStack<int, 2> s;
+
+    static_assert(sizeof(s) >= 2 * sizeof(int));
+
+    s.push(1);
+    s.push(2);
+
+    REQUIRE_THROWS_AS(s.push(3), std::length_error);
+    REQUIRE(s.size() == 2);
+    REQUIRE(s.top() == 2);
+}
+
+namespace
+{
+    struct ParserFrame
+    {
+        int state;
+        int token;
+        const char* position;
+    };
+
+    template <typename StackType>
+    size_t push_pop_deep(StackType& s, size_t depth)
+    {
+        for (size_t i = 0; i < depth; ++i)
+            s.push(ParserFrame{static_cast<int>(i), 1, nullptr});
+
+        size_t checksum = 0;
+        while (!s.empty())
+        {
+            checksum += s.top().state;
+            s.pop();
+        }
+
+        return checksum;
+    }
+
+    template <typename StackType>
+    size_t push_pop_shallow(StackType& s, size_t iterations, size_t depth)
+    {
+        size_t checksum = 0;
+
+        for (size_t n = 0; n < iterations; ++n)
+        {
+            for (size_t i = 0; i < depth; ++i)
+                s.push(ParserFrame{static_cast<int>(i), 1, nullptr});
+
+            while (!s.empty())
+            {
+                checksum += s.top().state;
+                s.pop();
+            }
+        }
+
+        return checksum;
+    }
+} // namespace
+
+TEST_CASE("Stack backing stores - benchmark", "[.][benchmark]")
+{
+    constexpr size_t deep = 1'000'000;
+    constexpr size_t iterations = 10'000;
+    constexpr size_t shallow = 32;
+
+    BENCHMARK("deep - Stack<Contiguous>")
+    {
+        Stack<ParserFrame> s;
+        return push_pop_deep(s, deep);
+    };
+
+    BENCHMARK("deep - Stack<Segmented>")
+    {
+        SegmentedStack<ParserFrame> s;
+        return push_pop_deep(s, deep);
+    };
+
+    BENCHMARK("deep - std::stack<deque>")
+    {
+        std::stack<ParserFrame, std::deque<ParserFrame>> s;
+        return push_pop_deep(s, deep);
+    };
+
+    BENCHMARK("deep - std::stack<vector>")
+    {
+        std::stack<ParserFrame, std::vector<ParserFrame>> s;
+        return push_pop_deep(s, deep);
+    };
+
+    BENCHMARK("shallow - Stack<Contiguous>")
+    {
+        Stack<ParserFrame> s;
+        return push_pop_shallow(s, iterations, shallow);
+    };
+
+    BENCHMARK("shallow - Stack<Segmented>")
+    {
+        SegmentedStack<ParserFrame> s;
+        return push_pop_shallow(s, iterations, shallow);
+    };
+
+    BENCHMARK("shallow - Stack<Inline>")
+    {
+        InlineStack<ParserFrame, shallow> s;
+        return push_pop_shallow(s, iterations, shallow);
+    };
+
+    BENCHMARK("shallow - std::stack<deque>")
+    {
+        std::stack<ParserFrame, std::deque<ParserFrame>> s;
+        return push_pop_shallow(s, iterations, shallow);
+    };
+
+    BENCHMARK("shallow - std::stack<vector>")
+    {
+        std::stack<ParserFrame, std::vector<ParserFrame>> s;
+        return push_pop_shallow(s, iterations, shallow);
+    };
+}
@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "gadget.hpp"
+#include "relocatable.hpp"
 
 namespace Helpers
 {
@@ -163,6 +164,12 @@ namespace Helpers
         }
     };
 
+    // String is relocatable with memcpy exactly when its std::string member is
+    template <>
+    struct is_trivially_relocatable<String> : is_trivially_relocatable<std::string>
+    {
+    };
+
     inline String operator+(const String& lhs, const String& rhs)
     {
         return String{lhs.value() + rhs.value()};
@@ -0,0 +1,449 @@
+#ifndef INTRUSIVE_PTR_HPP
+#define INTRUSIVE_PTR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // counting policies for RefCounted
+
+    namespace Detail
+    {
+        // NonAtomic - plain value with std::atomic-like interface
+        template <typename T>
+        class NonAtomic
+        {
+            T value_;
+
+        public:
+            constexpr NonAtomic(T value = T{}) noexcept
+                : value_{value}
+            {
+            }
+
+            T load(std::memory_order = std::memory_order_seq_cst) const noexcept
+            {
+                return value_;
+            }
+
+            void store(T value, std::memory_order = std::memory_order_seq_cst) noexcept
+            {
+                value_ = value;
+            }
+
+            T fetch_add(T arg, std::memory_order = std::memory_order_seq_cst) noexcept
+            {
+                return std::exchange(value_, value_ + arg);
+            }
+
+            T fetch_sub(T arg, std::memory_order = std::memory_order_seq_cst) noexcept
+            {
+                return std::exchange(value_, value_ - arg);
+            }
+
+            bool compare_exchange_strong(T& expected, T desired, std::memory_order = std::memory_order_seq_cst,
+                std::memory_order = std::memory_order_seq_cst) noexcept
+            {
+                if (value_ != expected)
+                {
+                    expected = value_;
+                    return false;
+                }
+
+                value_ = desired;
+                return true;
+            }
+
+            bool compare_exchange_weak(T& expected, T desired, std::memory_order success = std::memory_order_seq_cst,
+                std::memory_order failure = std::memory_order_seq_cst) noexcept
+            {
+                return compare_exchange_strong(expected, desired, success, failure);
+            }
+        };
+
+        struct NullMutex
+        {
+            void lock() noexcept
+            {
+            }
+
+            void unlock() noexcept
+            {
+            }
+        };
+    } // namespace Detail
+
+    // AtomicCounting - objects may be shared between threads
+    struct AtomicCounting
+    {
+        template <typename T>
+        using Atomic = std::atomic<T>;
+
+        using Mutex = std::mutex;
+    };
+
+    // NonAtomicCounting - objects never leave their thread, counters are plain integers
+    struct NonAtomicCounting
+    {
+        template <typename T>
+        using Atomic = Detail::NonAtomic<T>;
+
+        using Mutex = Detail::NullMutex;
+    };
+
+    template <typename T>
+    class intrusive_ptr;
+
+    template <typename T>
+    class intrusive_weak_ptr;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // RefCounted - CRTP base keeping the reference count inside the object
+    //
+    // Weak references use a small block allocated on the first intrusive_weak_ptr.
+    // The block keeps a pointer to the object - it is cleared under the block's mutex
+    // before the object is destroyed, so lock() never touches a destroyed object.
+
+    template <typename Derived, typename CountingPolicy = AtomicCounting>
+    class RefCounted
+    {
+        template <typename T>
+        using Atomic = typename CountingPolicy::template Atomic<T>;
+
+        struct WeakBlock
+        {
+            Atomic<size_t> weak_count{1}; // +1 while the object is alive
+            typename CountingPolicy::Mutex mtx;
+            const RefCounted* object; // guarded by mtx
+
+            explicit WeakBlock(const RefCounted* obj) noexcept
+                : object{obj}
+            {
+            }
+
+            void release() noexcept
+            {
+                if (weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete this;
+            }
+        };
+
+        mutable Atomic<size_t> ref_count_{0};
+        mutable Atomic<WeakBlock*> weak_block_{nullptr};
+
+        template <typename>
+        friend class intrusive_weak_ptr;
+
+    public:
+        using ref_counted_base = RefCounted;
+        using counting_policy = CountingPolicy;
+
+        size_t use_count() const noexcept
+        {
+            return ref_count_.load(std::memory_order_relaxed);
+        }
+
+        friend void intrusive_ptr_add_ref(const RefCounted* ptr) noexcept
+        {
+            ptr->ref_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        friend void intrusive_ptr_release(const RefCounted* ptr) noexcept
+        {
+            if (ptr->ref_count_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (WeakBlock* block = ptr->weak_block_.load(std::memory_order_acquire))
+            {
+                {
+                    std::lock_guard lk{block->mtx};
+                    block->object = nullptr;
+                }
+
+                block->release();
+            }
+
+            delete static_cast<const Derived*>(ptr);
+        }
+
+    protected:
+        RefCounted() = default;
+
+        // copy of an object is a new object - counters are not copied
+        RefCounted(const RefCounted&) noexcept
+        {
+        }
+
+        RefCounted& operator=(const RefCounted&) noexcept
+        {
+            return *this;
+        }
+
+        ~RefCounted() = default;
+
+    private:
+        bool try_add_ref() const noexcept
+        {
+            size_t count = ref_count_.load(std::memory_order_relaxed);
+
+            while (count != 0)
+            {
+                if (ref_count_.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // caller must hold a strong reference
+        WeakBlock* acquire_weak_block() const
+        {
+            WeakBlock* block = weak_block_.load(std::memory_order_acquire);
+
+            if (!block)
+            {
+                auto* created = new WeakBlock{this};
+
+                if (weak_block_.compare_exchange_strong(block, created, std::memory_order_acq_rel, std::memory_order_acquire))
+                    block = created;
+                else
+                    delete created;
+            }
+
+            block->weak_count.fetch_add(1, std::memory_order_relaxed);
+
+            return block;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // intrusive_ptr - shared ownership with the count stored in the object
+    //
+    // Works with any type providing intrusive_ptr_add_ref()/intrusive_ptr_release() found by ADL.
+
+    template <typename T>
+    class intrusive_ptr
+    {
+        T* ptr_ = nullptr;
+
+        template <typename>
+        friend class intrusive_ptr;
+
+    public:
+        using element_type = T;
+
+        constexpr intrusive_ptr() noexcept = default;
+
+        constexpr intrusive_ptr(std::nullptr_t) noexcept
+        {
+        }
+
+        // add_ref == false adopts a reference already owned by the caller
+        explicit intrusive_ptr(T* ptr, bool add_ref = true) noexcept
+            : ptr_{ptr}
+        {
+            if (ptr_ && add_ref)
+                intrusive_ptr_add_ref(ptr_);
+        }
+
+        intrusive_ptr(const intrusive_ptr& other) noexcept
+            : intrusive_ptr(other.ptr_)
+        {
+        }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        intrusive_ptr(const intrusive_ptr<U>& other) noexcept
+            : intrusive_ptr(other.ptr_)
+        {
+        }
+
+        intrusive_ptr(intrusive_ptr&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+        {
+        }
+
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        intrusive_ptr(intrusive_ptr<U>&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+        {
+        }
+
+        intrusive_ptr& operator=(const intrusive_ptr& other) noexcept
+        {
+            intrusive_ptr(other).swap(*this);
+            return *this;
+        }
+
+        intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+        {
+            intrusive_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~intrusive_ptr()
+        {
+            if (ptr_)
+                intrusive_ptr_release(ptr_);
+        }
+
+        void reset() noexcept
+        {
+            intrusive_ptr().swap(*this);
+        }
+
+        void reset(T* ptr, bool add_ref = true) noexcept
+        {
+            intrusive_ptr(ptr, add_ref).swap(*this);
+        }
+
+        // releases ownership without decrementing the count
+        [[nodiscard]] T* detach() noexcept
+        {
+            return std::exchange(ptr_, nullptr);
+        }
+
+        void swap(intrusive_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        T* get() const noexcept
+        {
+            return ptr_;
+        }
+
+        T& operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        T* operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+        template <typename U>
+        friend bool operator==(const intrusive_ptr& lhs, const intrusive_ptr<U>& rhs) noexcept
+        {
+            return lhs.get() == rhs.get();
+        }
+
+        friend bool operator==(const intrusive_ptr& lhs, std::nullptr_t) noexcept
+        {
+            return lhs.ptr_ == nullptr;
+        }
+
+        friend void swap(intrusive_ptr& lhs, intrusive_ptr& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+    };
+
+    template <typename T, typename... TArgs>
+    intrusive_ptr<T> make_intrusive(TArgs&&... args)
+    {
+        return intrusive_ptr<T>(new T(std::forward<TArgs>(args)...));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // intrusive_weak_ptr - non-owning reference to an object derived from RefCounted
+
+    template <typename T>
+    class intrusive_weak_ptr
+    {
+        using WeakBlock = typename T::ref_counted_base::WeakBlock;
+
+        T* ptr_ = nullptr;
+        WeakBlock* block_ = nullptr;
+
+    public:
+        using element_type = T;
+
+        constexpr intrusive_weak_ptr() noexcept = default;
+
+        intrusive_weak_ptr(const intrusive_ptr<T>& ptr)
+            : ptr_{ptr.get()}
+            , block_{ptr ? static_cast<const typename T::ref_counted_base*>(ptr.get())->acquire_weak_block() : nullptr}
+        {
+        }
+
+        intrusive_weak_ptr(const intrusive_weak_ptr& other) noexcept
+            : ptr_{other.ptr_}
+            , block_{other.block_}
+        {
+            if (block_)
+                block_->weak_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        intrusive_weak_ptr(intrusive_weak_ptr&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+            , block_{std::exchange(other.block_, nullptr)}
+        {
+        }
+
+        intrusive_weak_ptr& operator=(const intrusive_weak_ptr& other) noexcept
+        {
+            intrusive_weak_ptr(other).swap(*this);
+            return *this;
+        }
+
+        intrusive_weak_ptr& operator=(intrusive_weak_ptr&& other) noexcept
+        {
+            intrusive_weak_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~intrusive_weak_ptr()
+        {
+            if (block_)
+                block_->release();
+        }
+
+        void reset() noexcept
+        {
+            intrusive_weak_ptr().swap(*this);
+        }
+
+        void swap(intrusive_weak_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(block_, other.block_);
+        }
+
+        // returns nullptr if the object is already destroyed
+        intrusive_ptr<T> lock() const noexcept
+        {
+            if (!block_)
+                return nullptr;
+
+            std::lock_guard lk{block_->mtx};
+
+            if (block_->object && block_->object->try_add_ref())
+                return intrusive_ptr<T>(ptr_, false);
+
+            return nullptr;
+        }
+
+        bool expired() const noexcept
+        {
+            if (!block_)
+                return true;
+
+            std::lock_guard lk{block_->mtx};
+
+            return !block_->object || block_->object->use_count() == 0;
+        }
+    };
+} // namespace Helpers
+
+#endif // INTRUSIVE_PTR_HPP
@@ -0,0 +1,458 @@
+#ifndef LOCAL_SHARED_PTR_HPP
+#define LOCAL_SHARED_PTR_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // local_shared_ptr & local_weak_ptr - shared ownership for objects that never leave their thread
+    //
+    // Same shape as std::shared_ptr/std::weak_ptr, but the counts are plain integers.
+    // In debug builds every change of the counts asserts that it happens on the thread
+    // that created the control block.
+
+    namespace Detail
+    {
+        struct AdoptRef
+        {
+        };
+
+        class LocalControlBlock
+        {
+            size_t use_count_ = 1;
+            size_t weak_count_ = 1; // +1 while use_count_ != 0
+
+            // kept in every build - layout of the block must not depend on NDEBUG
+            std::thread::id owner_ = std::this_thread::get_id();
+
+        protected:
+            ~LocalControlBlock() = default;
+
+            virtual void dispose() noexcept = 0; // destroys the object
+            virtual void destroy() noexcept = 0; // deallocates the block
+
+        public:
+            LocalControlBlock() = default;
+            LocalControlBlock(const LocalControlBlock&) = delete;
+            LocalControlBlock& operator=(const LocalControlBlock&) = delete;
+
+            void check_owner_thread() const noexcept
+            {
+                assert(owner_ == std::this_thread::get_id() && "local_shared_ptr used from another thread");
+            }
+
+            size_t use_count() const noexcept
+            {
+                return use_count_;
+            }
+
+            void add_ref() noexcept
+            {
+                check_owner_thread();
+                ++use_count_;
+            }
+
+            bool add_ref_if_not_zero() noexcept
+            {
+                check_owner_thread();
+
+                if (use_count_ == 0)
+                    return false;
+
+                ++use_count_;
+                return true;
+            }
+
+            void release() noexcept
+            {
+                check_owner_thread();
+
+                if (--use_count_ == 0)
+                {
+                    dispose();
+                    release_weak();
+                }
+            }
+
+            void add_weak_ref() noexcept
+            {
+                check_owner_thread();
+                ++weak_count_;
+            }
+
+            void release_weak() noexcept
+            {
+                check_owner_thread();
+
+                if (--weak_count_ == 0)
+                    destroy();
+            }
+        };
+
+        template <typename T, typename Deleter>
+        class LocalPointerBlock final : public LocalControlBlock
+        {
+            T* ptr_;
+            [[no_unique_address]] Deleter deleter_;
+
+        public:
+            LocalPointerBlock(T* ptr, Deleter deleter) noexcept
+                : ptr_{ptr}
+                , deleter_{std::move(deleter)}
+            {
+            }
+
+        protected:
+            void dispose() noexcept override
+            {
+                deleter_(ptr_);
+            }
+
+            void destroy() noexcept override
+            {
+                delete this;
+            }
+        };
+
+        // object is constructed inside the block - one allocation
+        template <typename T>
+        class LocalInplaceBlock final : public LocalControlBlock
+        {
+            alignas(T) std::byte storage_[sizeof(T)];
+
+        public:
+            template <typename... TArgs>
+            explicit LocalInplaceBlock(TArgs&&... args)
+            {
+                ::new (static_cast<void*>(storage_)) T(std::forward<TArgs>(args)...);
+            }
+
+            T* get() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(storage_));
+            }
+
+        protected:
+            void dispose() noexcept override
+            {
+                std::destroy_at(get());
+            }
+
+            void destroy() noexcept override
+            {
+                delete this;
+            }
+        };
+    } // namespace Detail
+
+    template <typename T>
+    class local_weak_ptr;
+
+    template <typename T>
+    class local_shared_ptr
+    {
+        T* ptr_ = nullptr;
+        Detail::LocalControlBlock* block_ = nullptr;
+
+        template <typename>
+        friend class local_shared_ptr;
+
+        template <typename>
+        friend class local_weak_ptr;
+
+        template <typename U, typename... TArgs>
+        friend local_shared_ptr<U> make_local_shared(TArgs&&... args);
+
+        // adopts a reference already counted in block
+        local_shared_ptr(Detail::AdoptRef, T* ptr, Detail::LocalControlBlock* block) noexcept
+            : ptr_{ptr}
+            , block_{block}
+        {
+        }
+
+        template <typename U>
+        using EnableIfConvertible = std::enable_if_t<std::is_convertible_v<U*, T*>>;
+
+    public:
+        using element_type = T;
+        using weak_type = local_weak_ptr<T>;
+
+        constexpr local_shared_ptr() noexcept = default;
+
+        constexpr local_shared_ptr(std::nullptr_t) noexcept
+        {
+        }
+
+        template <typename U, typename = EnableIfConvertible<U>>
+        explicit local_shared_ptr(U* ptr)
+            : local_shared_ptr(ptr, std::default_delete<U>{})
+        {
+        }
+
+        template <typename U, typename Deleter, typename = EnableIfConvertible<U>>
+        local_shared_ptr(U* ptr, Deleter deleter)
+            : ptr_{ptr}
+        {
+            try
+            {
+                block_ = new Detail::LocalPointerBlock<U, Deleter>(ptr, deleter);
+            }
+            catch (...)
+            {
+                deleter(ptr);
+                throw;
+            }
+        }
+
+        // aliasing constructor - shares ownership with other, points to ptr
+        template <typename U>
+        local_shared_ptr(const local_shared_ptr<U>& other, T* ptr) noexcept
+            : ptr_{ptr}
+            , block_{other.block_}
+        {
+            if (block_)
+                block_->add_ref();
+        }
+
+        local_shared_ptr(const local_shared_ptr& other) noexcept
+            : local_shared_ptr(other, other.ptr_)
+        {
+        }
+
+        template <typename U, typename = EnableIfConvertible<U>>
+        local_shared_ptr(const local_shared_ptr<U>& other) noexcept
+            : local_shared_ptr(other, other.ptr_)
+        {
+        }
+
+        local_shared_ptr(local_shared_ptr&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+            , block_{std::exchange(other.block_, nullptr)}
+        {
+        }
+
+        template <typename U, typename = EnableIfConvertible<U>>
+        local_shared_ptr(local_shared_ptr<U>&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+            , block_{std::exchange(other.block_, nullptr)}
+        {
+        }
+
+        // throws std::bad_weak_ptr if the object is already destroyed
+        template <typename U, typename = EnableIfConvertible<U>>
+        explicit local_shared_ptr(const local_weak_ptr<U>& weak)
+            : ptr_{weak.ptr_}
+            , block_{weak.block_}
+        {
+            if (!block_ || !block_->add_ref_if_not_zero())
+                throw std::bad_weak_ptr{};
+        }
+
+        template <typename U, typename Deleter, typename = EnableIfConvertible<U>>
+        local_shared_ptr(std::unique_ptr<U, Deleter>&& uptr)
+        {
+            using StoredDeleter = std::conditional_t<std::is_reference_v<Deleter>,
+                std::reference_wrapper<std::remove_reference_t<Deleter>>, Deleter>;
+
+            if (uptr)
+            {
+                // if allocation throws uptr still owns the object
+                block_ = new Detail::LocalPointerBlock<U, StoredDeleter>(uptr.get(), std::forward<Deleter>(uptr.get_deleter()));
+                ptr_ = uptr.release();
+            }
+        }
+
+        local_shared_ptr& operator=(const local_shared_ptr& other) noexcept
+        {
+            local_shared_ptr(other).swap(*this);
+            return *this;
+        }
+
+        local_shared_ptr& operator=(local_shared_ptr&& other) noexcept
+        {
+            local_shared_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~local_shared_ptr()
+        {
+            if (block_)
+                block_->release();
+        }
+
+        void reset() noexcept
+        {
+            local_shared_ptr().swap(*this);
+        }
+
+        template <typename U, typename = EnableIfConvertible<U>>
+        void reset(U* ptr)
+        {
+            local_shared_ptr(ptr).swap(*this);
+        }
+
+        void swap(local_shared_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(block_, other.block_);
+        }
+
+        T* get() const noexcept
+        {
+            return ptr_;
+        }
+
+        T& operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        T* operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+        size_t use_count() const noexcept
+        {
+            return block_ ? block_->use_count() : 0;
+        }
+
+        template <typename U>
+        friend bool operator==(const local_shared_ptr& lhs, const local_shared_ptr<U>& rhs) noexcept
+        {
+            return lhs.get() == rhs.get();
+        }
+
+        friend bool operator==(const local_shared_ptr& lhs, std::nullptr_t) noexcept
+        {
+            return lhs.ptr_ == nullptr;
+        }
+
+        friend void swap(local_shared_ptr& lhs, local_shared_ptr& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+    };
+
+    template <typename T, typename... TArgs>
+    local_shared_ptr<T> make_local_shared(TArgs&&... args)
+    {
+        auto* block = new Detail::LocalInplaceBlock<T>(std::forward<TArgs>(args)...);
+        return local_shared_ptr<T>(Detail::AdoptRef{}, block->get(), block);
+    }
+
+    template <typename T>
+    class local_weak_ptr
+    {
+        T* ptr_ = nullptr;
+        Detail::LocalControlBlock* block_ = nullptr;
+
+        template <typename>
+        friend class local_weak_ptr;
+
+        template <typename>
+        friend class local_shared_ptr;
+
+        template <typename U>
+        using EnableIfConvertible = std::enable_if_t<std::is_convertible_v<U*, T*>>;
+
+    public:
+        using element_type = T;
+
+        constexpr local_weak_ptr() noexcept = default;
+
+        template <typename U, typename = EnableIfConvertible<U>>
+        local_weak_ptr(const local_shared_ptr<U>& shared) noexcept
+            : ptr_{shared.ptr_}
+            , block_{shared.block_}
+        {
+            if (block_)
+                block_->add_weak_ref();
+        }
+
+        local_weak_ptr(const local_weak_ptr& other) noexcept
+            : ptr_{other.ptr_}
+            , block_{other.block_}
+        {
+            if (block_)
+                block_->add_weak_ref();
+        }
+
+        template <typename U, typename = EnableIfConvertible<U>>
+        local_weak_ptr(const local_weak_ptr<U>& other) noexcept
+            : ptr_{other.ptr_}
+            , block_{other.block_}
+        {
+            if (block_)
+                block_->add_weak_ref();
+        }
+
+        local_weak_ptr(local_weak_ptr&& other) noexcept
+            : ptr_{std::exchange(other.ptr_, nullptr)}
+            , block_{std::exchange(other.block_, nullptr)}
+        {
+        }
+
+        local_weak_ptr& operator=(const local_weak_ptr& other) noexcept
+        {
+            local_weak_ptr(other).swap(*this);
+            return *this;
+        }
+
+        local_weak_ptr& operator=(local_weak_ptr&& other) noexcept
+        {
+            local_weak_ptr(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~local_weak_ptr()
+        {
+            if (block_)
+                block_->release_weak();
+        }
+
+        void reset() noexcept
+        {
+            local_weak_ptr().swap(*this);
+        }
+
+        void swap(local_weak_ptr& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            std::swap(block_, other.block_);
+        }
+
+        size_t use_count() const noexcept
+        {
+            return block_ ? block_->use_count() : 0;
+        }
+
+        bool expired() const noexcept
+        {
+            return use_count() == 0;
+        }
+
+        local_shared_ptr<T> lock() const noexcept
+        {
+            if (block_ && block_->add_ref_if_not_zero())
+                return local_shared_ptr<T>(Detail::AdoptRef{}, ptr_, block_);
+
+            return nullptr;
+        }
+    };
+} // namespace Helpers
+
+#endif // LOCAL_SHARED_PTR_HPP
@@ -0,0 +1,489 @@
+#ifndef MEMORY_RESOURCES_HPP
+#define MEMORY_RESOURCES_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // MemoryStats - snapshot of memory resource usage
+
+    struct MemoryStats
+    {
+        size_t bytes_used = 0;      // bytes handed out to clients and not released yet
+        size_t peak_bytes_used = 0; // max of bytes_used since construction
+        size_t bytes_reserved = 0;  // bytes acquired from upstream resource
+        size_t chunks = 0;          // number of blocks acquired from upstream resource
+
+        MemoryStats& operator+=(const MemoryStats& other) noexcept
+        {
+            bytes_used += other.bytes_used;
+            peak_bytes_used += other.peak_bytes_used;
+            bytes_reserved += other.bytes_reserved;
+            chunks += other.chunks;
+
+            return *this;
+        }
+    };
+
+    namespace Detail
+    {
+        // counters are written by the owner thread only - atomics allow stats to be read from other threads
+        class StatsCounters
+        {
+            std::atomic<size_t> bytes_used_{0};
+            std::atomic<size_t> peak_bytes_used_{0};
+            std::atomic<size_t> bytes_reserved_{0};
+            std::atomic<size_t> chunks_{0};
+
+            static void add(std::atomic<size_t>& counter, size_t value) noexcept
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+            static void subtract(std::atomic<size_t>& counter, size_t value) noexcept
+            {
+                counter.store(counter.load(std::memory_order_relaxed) - value, std::memory_order_relaxed);
+            }
+
+        public:
+            void allocated(size_t bytes) noexcept
+            {
+                add(bytes_used_, bytes);
+
+                const size_t used = bytes_used_.load(std::memory_order_relaxed);
+                if (used > peak_bytes_used_.load(std::memory_order_relaxed))
+                    peak_bytes_used_.store(used, std::memory_order_relaxed);
+            }
+
+            void deallocated(size_t bytes) noexcept
+            {
+                subtract(bytes_used_, bytes);
+            }
+
+            void chunk_acquired(size_t bytes) noexcept
+            {
+                add(bytes_reserved_, bytes);
+                add(chunks_, 1);
+            }
+
+            void chunk_released(size_t bytes) noexcept
+            {
+                subtract(bytes_reserved_, bytes);
+                subtract(chunks_, 1);
+            }
+
+            void reset_usage() noexcept
+            {
+                bytes_used_.store(0, std::memory_order_relaxed);
+            }
+
+            MemoryStats snapshot() const noexcept
+            {
+                return MemoryStats{
+                    bytes_used_.load(std::memory_order_relaxed),
+                    peak_bytes_used_.load(std::memory_order_relaxed),
+                    bytes_reserved_.load(std::memory_order_relaxed),
+                    chunks_.load(std::memory_order_relaxed)};
+            }
+        };
+
+        inline std::byte* align_up(std::byte* ptr, size_t alignment) noexcept
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+            return ptr + ((alignment - address % alignment) % alignment);
+        }
+    } // namespace Detail
+
+    ////////////////////////////////////////////////////////////////////////////
+    // ArenaResource - bump-pointer allocator
+    //
+    // Allocation moves a pointer inside the current chunk, deallocation is no-op.
+    // Memory is returned to upstream resource all at once - by release() or destructor.
+    // Chunks grow geometrically. Not thread-safe - use one arena per thread (see thread_arena()).
+
+    class ArenaResource : public std::pmr::memory_resource
+    {
+        struct ChunkHeader
+        {
+            ChunkHeader* next;
+            size_t size; // including header
+        };
+
+        std::pmr::memory_resource* upstream_;
+        size_t initial_chunk_size_;
+        size_t next_chunk_size_;
+        ChunkHeader* chunks_ = nullptr;
+        std::byte* current_ = nullptr;
+        std::byte* end_ = nullptr;
+        std::byte* initial_buffer_ = nullptr;
+        size_t initial_buffer_size_ = 0;
+        Detail::StatsCounters stats_;
+
+    public:
+        static constexpr size_t default_chunk_size = 64 * 1024;
+
+        explicit ArenaResource(size_t initial_chunk_size = default_chunk_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : upstream_{upstream}
+            , initial_chunk_size_{std::max(initial_chunk_size, sizeof(ChunkHeader) + alignof(std::max_align_t))}
+            , next_chunk_size_{initial_chunk_size_}
+        {
+        }
+
+        // buffer is used first - it is not owned by the arena
+        ArenaResource(void* buffer, size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : ArenaResource(std::max(size, default_chunk_size), upstream)
+        {
+            initial_buffer_ = static_cast<std::byte*>(buffer);
+            initial_buffer_size_ = size;
+            current_ = initial_buffer_;
+            end_ = initial_buffer_ + initial_buffer_size_;
+        }
+
+        ArenaResource(const ArenaResource&) = delete;
+        ArenaResource& operator=(const ArenaResource&) = delete;
+
+        ~ArenaResource() override
+        {
+            release();
+        }
+
+        // all memory allocated from the arena is released at once
+        void release() noexcept
+        {
+            while (chunks_)
+            {
+                ChunkHeader* next = chunks_->next;
+                stats_.chunk_released(chunks_->size);
+                upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+                chunks_ = next;
+            }
+
+            next_chunk_size_ = initial_chunk_size_;
+            current_ = initial_buffer_;
+            end_ = initial_buffer_ + initial_buffer_size_;
+            stats_.reset_usage();
+        }
+
+        MemoryStats stats() const noexcept
+        {
+            return stats_.snapshot();
+        }
+
+        std::pmr::memory_resource* upstream_resource() const noexcept
+        {
+            return upstream_;
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            std::byte* ptr = Detail::align_up(current_, alignment);
+
+            if (current_ == nullptr || ptr > end_ || bytes > static_cast<size_t>(end_ - ptr))
+            {
+                allocate_chunk(bytes + alignment);
+                ptr = Detail::align_up(current_, alignment);
+            }
+
+            current_ = ptr + bytes;
+            stats_.allocated(bytes);
+
+            return ptr;
+        }
+
+        void do_deallocate(void*, size_t, size_t) override
+        {
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        void allocate_chunk(size_t min_bytes)
+        {
+            const size_t chunk_size = std::max(next_chunk_size_, min_bytes + sizeof(ChunkHeader));
+
+            auto* chunk = static_cast<ChunkHeader*>(upstream_->allocate(chunk_size, alignof(std::max_align_t)));
+            chunk->next = chunks_;
+            chunk->size = chunk_size;
+            chunks_ = chunk;
+
+            current_ = reinterpret_cast<std::byte*>(chunk) + sizeof(ChunkHeader);
+            end_ = reinterpret_cast<std::byte*>(chunk) + chunk_size;
+            next_chunk_size_ = chunk_size * 2;
+
+            stats_.chunk_acquired(chunk_size);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // PoolResource - size-class pool allocator
+    //
+    // Requests are rounded up to power-of-two size classes. Each class keeps a free list
+    // of blocks carved from chunks acquired from upstream - deallocated blocks are reused.
+    // Requests larger than max_block_size are forwarded to upstream resource.
+    // Not thread-safe.
+
+    class PoolResource : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t min_block_size = 8;
+        static constexpr size_t max_block_size = 4096;
+
+    private:
+        static constexpr size_t size_classes = std::bit_width(max_block_size) - std::bit_width(min_block_size) + 1;
+        static constexpr size_t min_blocks_per_chunk = 16;
+        static constexpr size_t max_chunk_size = 256 * 1024;
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        // placed after the blocks of a chunk - blocks stay aligned to their size
+        struct ChunkFooter
+        {
+            ChunkFooter* next;
+            size_t blocks_size;
+            size_t block_size;
+        };
+
+        struct Pool
+        {
+            FreeBlock* free_list = nullptr;
+            size_t blocks_per_chunk = min_blocks_per_chunk;
+        };
+
+        std::pmr::memory_resource* upstream_;
+        std::array<Pool, size_classes> pools_{};
+        ChunkFooter* chunks_ = nullptr;
+        Detail::StatsCounters stats_;
+
+    public:
+        explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+            : upstream_{upstream}
+        {
+        }
+
+        PoolResource(const PoolResource&) = delete;
+        PoolResource& operator=(const PoolResource&) = delete;
+
+        ~PoolResource() override
+        {
+            release();
+        }
+
+        // chunks of all pools are returned to upstream - blocks larger than max_block_size must be deallocated by clients
+        void release() noexcept
+        {
+            while (chunks_)
+            {
+                ChunkFooter* next = chunks_->next;
+                const size_t chunk_size = chunks_->blocks_size + sizeof(ChunkFooter);
+                std::byte* chunk = reinterpret_cast<std::byte*>(chunks_) - chunks_->blocks_size;
+
+                stats_.chunk_released(chunk_size);
+                upstream_->deallocate(chunk, chunk_size, chunk_alignment(chunks_->block_size));
+                chunks_ = next;
+            }
+
+            pools_ = {};
+            stats_.reset_usage();
+        }
+
+        MemoryStats stats() const noexcept
+        {
+            return stats_.snapshot();
+        }
+
+        std::pmr::memory_resource* upstream_resource() const noexcept
+        {
+            return upstream_;
+        }
+
+        static size_t block_size_for(size_t bytes, size_t alignment) noexcept
+        {
+            return std::bit_ceil(std::max({bytes, alignment, min_block_size}));
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            const size_t block_size = block_size_for(bytes, alignment);
+
+            if (block_size > max_block_size)
+            {
+                void* ptr = upstream_->allocate(bytes, alignment);
+                stats_.allocated(bytes);
+                return ptr;
+            }
+
+            Pool& pool = pools_[size_class(block_size)];
+            if (!pool.free_list)
+                allocate_chunk(pool, block_size);
+
+            FreeBlock* block = std::exchange(pool.free_list, pool.free_list->next);
+            stats_.allocated(block_size);
+
+            return block;
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            const size_t block_size = block_size_for(bytes, alignment);
+
+            if (block_size > max_block_size)
+            {
+                upstream_->deallocate(ptr, bytes, alignment);
+                stats_.deallocated(bytes);
+                return;
+            }
+
+            Pool& pool = pools_[size_class(block_size)];
+            pool.free_list = ::new (ptr) FreeBlock{pool.free_list};
+            stats_.deallocated(block_size);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        static size_t size_class(size_t block_size) noexcept
+        {
+            return std::bit_width(block_size) - std::bit_width(min_block_size);
+        }
+
+        static size_t chunk_alignment(size_t block_size) noexcept
+        {
+            return std::max(block_size, alignof(ChunkFooter));
+        }
+
+        void allocate_chunk(Pool& pool, size_t block_size)
+        {
+            const size_t blocks_size = pool.blocks_per_chunk * block_size;
+            const size_t chunk_size = blocks_size + sizeof(ChunkFooter);
+
+            auto* chunk = static_cast<std::byte*>(upstream_->allocate(chunk_size, chunk_alignment(block_size)));
+            chunks_ = ::new (chunk + blocks_size) ChunkFooter{chunks_, blocks_size, block_size};
+            stats_.chunk_acquired(chunk_size);
+
+            // blocks are linked in address order
+            for (size_t i = pool.blocks_per_chunk; i-- > 0;)
+                pool.free_list = ::new (chunk + i * block_size) FreeBlock{pool.free_list};
+
+            if (blocks_size * 2 <= max_chunk_size)
+                pool.blocks_per_chunk *= 2;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // ArenaRegistry - one arena per thread
+    //
+    // Arena of a thread is created on first use and destroyed at thread exit.
+    // Peak usage of destroyed arenas is kept, so total_stats() covers the whole program.
+
+    class ArenaRegistry
+    {
+        mutable std::mutex mtx_;
+        std::vector<const ArenaResource*> arenas_;
+        MemoryStats retired_stats_;
+
+        class ThreadArena
+        {
+            ArenaRegistry& registry_;
+            ArenaResource arena_;
+
+        public:
+            explicit ThreadArena(ArenaRegistry& registry)
+                : registry_{registry}
+            {
+                registry_.attach(arena_);
+            }
+
+            ThreadArena(const ThreadArena&) = delete;
+            ThreadArena& operator=(const ThreadArena&) = delete;
+
+            ~ThreadArena()
+            {
+                registry_.detach(arena_);
+            }
+
+            ArenaResource& arena() noexcept
+            {
+                return arena_;
+            }
+        };
+
+        ArenaRegistry() = default;
+
+        void attach(const ArenaResource& arena)
+        {
+            std::lock_guard lk{mtx_};
+            arenas_.push_back(&arena);
+        }
+
+        void detach(const ArenaResource& arena) noexcept
+        {
+            std::lock_guard lk{mtx_};
+            retired_stats_.peak_bytes_used += arena.stats().peak_bytes_used; // memory of the arena is released with it
+            arenas_.erase(std::find(arenas_.begin(), arenas_.end(), &arena));
+        }
+
+    public:
+        ArenaRegistry(const ArenaRegistry&) = delete;
+        ArenaRegistry& operator=(const ArenaRegistry&) = delete;
+
+        static ArenaRegistry& instance()
+        {
+            static ArenaRegistry registry;
+            return registry;
+        }
+
+        ArenaResource& local_arena()
+        {
+            thread_local ThreadArena thread_arena{*this};
+            return thread_arena.arena();
+        }
+
+        size_t arena_count() const
+        {
+            std::lock_guard lk{mtx_};
+            return arenas_.size();
+        }
+
+        // sum of stats of live & retired arenas - peaks are summed per arena
+        MemoryStats total_stats() const
+        {
+            std::lock_guard lk{mtx_};
+
+            MemoryStats total = retired_stats_;
+            for (const ArenaResource* arena : arenas_)
+                total += arena->stats();
+
+            return total;
+        }
+    };
+
+    // arena owned by the calling thread
+    inline ArenaResource& thread_arena()
+    {
+        return ArenaRegistry::instance().local_arena();
+    }
+} // namespace Helpers
+
+#endif // MEMORY_RESOURCES_HPP
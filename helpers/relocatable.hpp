@@ -0,0 +1,76 @@
+#ifndef RELOCATABLE_HPP
+#define RELOCATABLE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace Helpers
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // is_trivially_relocatable - opt-in trait
+    //
+    // Relocation = move-construction into a new place + destruction of the source.
+    // For types marked as trivially relocatable it is done with memcpy/memmove
+    // and the source is treated as destroyed (its destructor is not called).
+
+    template <typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    template <typename T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type
+    {
+    };
+
+    template <typename T, typename Deleter>
+    struct is_trivially_relocatable<std::unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter>
+    {
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // relocation algorithms - source range is left as raw memory
+
+    template <typename T>
+    T* uninitialized_relocate_n(T* first, size_t count, T* dest)
+    {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (count != 0)
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+
+            return dest + count;
+        }
+        else
+        {
+            T* result;
+
+            // items are moved only if it cannot break the strong exception guarantee
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                result = std::uninitialized_move_n(first, count, dest).second;
+            else
+                result = std::uninitialized_copy_n(first, count, dest);
+
+            std::destroy_n(first, count);
+
+            return result;
+        }
+    }
+
+    // overlapping ranges are allowed - only for trivially relocatable types
+    template <typename T>
+    void relocate_overlapping_n(T* first, size_t count, T* dest) noexcept
+    {
+        static_assert(is_trivially_relocatable_v<T>);
+
+        if (count != 0)
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+    }
+} // namespace Helpers
+
+#endif
@@ -0,0 +1,687 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIMD_KERNELS_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// Simd - vectorized kernels for contiguous ranges of arithmetic types
+//
+// Every kernel exists in three versions (Scalar, Sse2, Avx2). Dispatching functions
+// select the best instruction set supported by a CPU at runtime.
+// Results of floating point sum may differ from Scalar in rounding (different order of additions).
+// Results of min/max are unspecified if a range contains NaN.
+
+namespace Simd
+{
+    // types compared & filled by kernels - bitwise representation without padding
+    template <typename T>
+    concept Vectorizable = std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    template <typename T>
+    concept Reducible = Vectorizable<T> && !std::is_same_v<T, bool>;
+
+    // integers are summed in 64-bit accumulator to avoid overflow
+    template <typename T>
+    using sum_type_t = std::conditional_t<std::is_floating_point_v<T>, T, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+    enum class InstructionSet {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    namespace Scalar
+    {
+        template <Vectorizable T>
+        bool equal(const T* a, const T* b, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!(a[i] == b[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        template <Vectorizable T>
+        void fill(T* dest, size_t count, T value) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                dest[i] = value;
+        }
+
+        // returns index of the first item equal to value or count
+        template <Vectorizable T>
+        size_t find(const T* items, size_t count, T value) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (items[i] == value)
+                    return i;
+            }
+            return count;
+        }
+
+        template <Reducible T>
+        sum_type_t<T> sum(const T* items, size_t count) noexcept
+        {
+            sum_type_t<T> result{};
+            for (size_t i = 0; i < count; ++i)
+                result += items[i];
+            return result;
+        }
+
+        // count > 0
+        template <Reducible T>
+        T min(const T* items, size_t count) noexcept
+        {
+            T result = items[0];
+            for (size_t i = 1; i < count; ++i)
+            {
+                if (items[i] < result)
+                    result = items[i];
+            }
+            return result;
+        }
+
+        // count > 0
+        template <Reducible T>
+        T max(const T* items, size_t count) noexcept
+        {
+            T result = items[0];
+            for (size_t i = 1; i < count; ++i)
+            {
+                if (result < items[i])
+                    result = items[i];
+            }
+            return result;
+        }
+    } // namespace Scalar
+
+    namespace Detail
+    {
+        // value repeated to fill a whole register of Bytes bytes
+        template <size_t Bytes, typename T>
+        struct alignas(32) FillPattern
+        {
+            unsigned char bytes[Bytes];
+
+            explicit FillPattern(T value) noexcept
+            {
+                for (size_t offset = 0; offset < Bytes; offset += sizeof(T))
+                    std::memcpy(bytes + offset, &value, sizeof(T));
+            }
+        };
+
+        template <typename T>
+        inline constexpr bool has_simd_reduction_v = std::is_same_v<T, std::int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+    } // namespace Detail
+
+#ifdef SIMD_KERNELS_X86_64
+    // SSE2 is a part of x86-64 baseline - always available
+    namespace Sse2
+    {
+        template <Vectorizable T>
+        bool equal(const T* a, const T* b, size_t count) noexcept
+        {
+            size_t i = 0;
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                for (; i + 4 <= count; i += 4)
+                {
+                    if (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))) != 0xF)
+                        return false;
+                }
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                for (; i + 2 <= count; i += 2)
+                {
+                    if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i))) != 0x3)
+                        return false;
+                }
+            }
+            else
+            {
+                // integers are equal when their bytes are equal
+                constexpr size_t items_per_register = 16 / sizeof(T);
+                for (; i + items_per_register <= count; i += items_per_register)
+                {
+                    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                    const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF)
+                        return false;
+                }
+            }
+
+            return Scalar::equal(a + i, b + i, count - i);
+        }
+
+        template <Vectorizable T>
+        void fill(T* dest, size_t count, T value) noexcept
+        {
+            constexpr size_t items_per_register = 16 / sizeof(T);
+            const Detail::FillPattern<16, T> pattern{value};
+            const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern.bytes));
+
+            size_t i = 0;
+            for (; i + items_per_register <= count; i += items_per_register)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), v);
+
+            Scalar::fill(dest + i, count - i, value);
+        }
+
+        template <Vectorizable T>
+        size_t find(const T* items, size_t count, T value) noexcept
+        {
+            size_t i = 0;
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                const __m128 v = _mm_set1_ps(value);
+                for (; i + 4 <= count; i += 4)
+                {
+                    if (const unsigned mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(items + i), v)))
+                        return i + std::countr_zero(mask);
+                }
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                const __m128d v = _mm_set1_pd(value);
+                for (; i + 2 <= count; i += 2)
+                {
+                    if (const unsigned mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(items + i), v)))
+                        return i + std::countr_zero(mask);
+                }
+            }
+            else
+            {
+                constexpr size_t items_per_register = 16 / sizeof(T);
+                const Detail::FillPattern<16, T> pattern{value};
+                const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern.bytes));
+
+                for (; i + items_per_register <= count; i += items_per_register)
+                {
+                    const __m128i items_v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+                    __m128i eq;
+
+                    if constexpr (sizeof(T) == 1)
+                        eq = _mm_cmpeq_epi8(items_v, v);
+                    else if constexpr (sizeof(T) == 2)
+                        eq = _mm_cmpeq_epi16(items_v, v);
+                    else if constexpr (sizeof(T) == 4)
+                        eq = _mm_cmpeq_epi32(items_v, v);
+                    else
+                    {
+                        // SSE2 has no 64-bit compare - both 32-bit halves must be equal
+                        const __m128i eq32 = _mm_cmpeq_epi32(items_v, v);
+                        eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+                    }
+
+                    // one bit per byte - all bytes of an equal item are set
+                    if (const unsigned mask = _mm_movemask_epi8(eq))
+                        return i + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+
+            return i + Scalar::find(items + i, count - i, value);
+        }
+
+        template <Reducible T>
+        sum_type_t<T> sum(const T* items, size_t count) noexcept
+        {
+            if constexpr (!Detail::has_simd_reduction_v<T>)
+            {
+                return Scalar::sum(items, count);
+            }
+            else
+            {
+                size_t i = 0;
+                sum_type_t<T> result{};
+
+                if constexpr (std::is_same_v<T, std::int32_t>)
+                {
+                    __m128i acc_lo = _mm_setzero_si128();
+                    __m128i acc_hi = _mm_setzero_si128();
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+                        const __m128i sign = _mm_srai_epi32(v, 31); // sign extension to 64 bits
+                        acc_lo = _mm_add_epi64(acc_lo, _mm_unpacklo_epi32(v, sign));
+                        acc_hi = _mm_add_epi64(acc_hi, _mm_unpackhi_epi32(v, sign));
+                    }
+
+                    alignas(16) std::int64_t lanes[2];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(acc_lo, acc_hi));
+                    result = lanes[0] + lanes[1];
+                }
+                else if constexpr (std::is_same_v<T, float>)
+                {
+                    __m128 acc = _mm_setzero_ps();
+                    for (; i + 4 <= count; i += 4)
+                        acc = _mm_add_ps(acc, _mm_loadu_ps(items + i));
+
+                    alignas(16) float lanes[4];
+                    _mm_store_ps(lanes, acc);
+                    result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+                }
+                else
+                {
+                    __m128d acc = _mm_setzero_pd();
+                    for (; i + 2 <= count; i += 2)
+                        acc = _mm_add_pd(acc, _mm_loadu_pd(items + i));
+
+                    alignas(16) double lanes[2];
+                    _mm_store_pd(lanes, acc);
+                    result = lanes[0] + lanes[1];
+                }
+
+                return result + Scalar::sum(items + i, count - i);
+            }
+        }
+
+        template <bool IsMax, Reducible T>
+        T min_max(const T* items, size_t count) noexcept
+        {
+            if constexpr (!Detail::has_simd_reduction_v<T>)
+            {
+                return IsMax ? Scalar::max(items, count) : Scalar::min(items, count);
+            }
+            else
+            {
+                constexpr size_t items_per_register = 16 / sizeof(T);
+                if (count < items_per_register)
+                    return IsMax ? Scalar::max(items, count) : Scalar::min(items, count);
+
+                alignas(16) T lanes[items_per_register];
+                size_t i = items_per_register;
+
+                if constexpr (std::is_same_v<T, std::int32_t>)
+                {
+                    // SSE2 has no min/max for 32-bit integers - select with compare mask
+                    __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items));
+                    for (; i + items_per_register <= count; i += items_per_register)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+                        const __m128i take_v = IsMax ? _mm_cmpgt_epi32(v, acc) : _mm_cmplt_epi32(v, acc);
+                        acc = _mm_or_si128(_mm_and_si128(take_v, v), _mm_andnot_si128(take_v, acc));
+                    }
+                    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+                }
+                else if constexpr (std::is_same_v<T, float>)
+                {
+                    __m128 acc = _mm_loadu_ps(items);
+                    for (; i + items_per_register <= count; i += items_per_register)
+                        acc = IsMax ? _mm_max_ps(acc, _mm_loadu_ps(items + i)) : _mm_min_ps(acc, _mm_loadu_ps(items + i));
+                    _mm_store_ps(lanes, acc);
+                }
+                else
+                {
+                    __m128d acc = _mm_loadu_pd(items);
+                    for (; i + items_per_register <= count; i += items_per_register)
+                        acc = IsMax ? _mm_max_pd(acc, _mm_loadu_pd(items + i)) : _mm_min_pd(acc, _mm_loadu_pd(items + i));
+                    _mm_store_pd(lanes, acc);
+                }
+
+                T result = IsMax ? Scalar::max(lanes, items_per_register) : Scalar::min(lanes, items_per_register);
+                if (i < count)
+                {
+                    const T tail_result = IsMax ? Scalar::max(items + i, count - i) : Scalar::min(items + i, count - i);
+                    result = IsMax ? std::max(result, tail_result) : std::min(result, tail_result);
+                }
+
+                return result;
+            }
+        }
+
+        template <Reducible T>
+        T min(const T* items, size_t count) noexcept
+        {
+            return min_max<false>(items, count);
+        }
+
+        template <Reducible T>
+        T max(const T* items, size_t count) noexcept
+        {
+            return min_max<true>(items, count);
+        }
+    } // namespace Sse2
+
+    // AVX2 kernels are compiled for AVX2 regardless of compiler flags - call them only after runtime check
+    namespace Avx2
+    {
+        template <Vectorizable T>
+        SIMD_TARGET_AVX2 bool equal(const T* a, const T* b, size_t count) noexcept
+        {
+            size_t i = 0;
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                for (; i + 8 <= count; i += 8)
+                {
+                    if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ)) != 0xFF)
+                        return false;
+                }
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                for (; i + 4 <= count; i += 4)
+                {
+                    if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ)) != 0xF)
+                        return false;
+                }
+            }
+            else
+            {
+                constexpr size_t items_per_register = 32 / sizeof(T);
+                for (; i + items_per_register <= count; i += items_per_register)
+                {
+                    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)) != -1)
+                        return false;
+                }
+            }
+
+            return Scalar::equal(a + i, b + i, count - i);
+        }
+
+        template <Vectorizable T>
+        SIMD_TARGET_AVX2 void fill(T* dest, size_t count, T value) noexcept
+        {
+            constexpr size_t items_per_register = 32 / sizeof(T);
+            const Detail::FillPattern<32, T> pattern{value};
+            const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(pattern.bytes));
+
+            size_t i = 0;
+            for (; i + items_per_register <= count; i += items_per_register)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), v);
+
+            Scalar::fill(dest + i, count - i, value);
+        }
+
+        template <Vectorizable T>
+        SIMD_TARGET_AVX2 size_t find(const T* items, size_t count, T value) noexcept
+        {
+            size_t i = 0;
+
+            if constexpr (std::is_same_v<T, float>)
+            {
+                const __m256 v = _mm256_set1_ps(value);
+                for (; i + 8 <= count; i += 8)
+                {
+                    if (const unsigned mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(items + i), v, _CMP_EQ_OQ)))
+                        return i + std::countr_zero(mask);
+                }
+            }
+            else if constexpr (std::is_same_v<T, double>)
+            {
+                const __m256d v = _mm256_set1_pd(value);
+                for (; i + 4 <= count; i += 4)
+                {
+                    if (const unsigned mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(items + i), v, _CMP_EQ_OQ)))
+                        return i + std::countr_zero(mask);
+                }
+            }
+            else
+            {
+                constexpr size_t items_per_register = 32 / sizeof(T);
+                const Detail::FillPattern<32, T> pattern{value};
+                const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(pattern.bytes));
+
+                for (; i + items_per_register <= count; i += items_per_register)
+                {
+                    const __m256i items_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i));
+                    __m256i eq;
+
+                    if constexpr (sizeof(T) == 1)
+                        eq = _mm256_cmpeq_epi8(items_v, v);
+                    else if constexpr (sizeof(T) == 2)
+                        eq = _mm256_cmpeq_epi16(items_v, v);
+                    else if constexpr (sizeof(T) == 4)
+                        eq = _mm256_cmpeq_epi32(items_v, v);
+                    else
+                        eq = _mm256_cmpeq_epi64(items_v, v);
+
+                    if (const unsigned mask = _mm256_movemask_epi8(eq))
+                        return i + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+
+            return i + Scalar::find(items + i, count - i, value);
+        }
+
+        template <Reducible T>
+        SIMD_TARGET_AVX2 sum_type_t<T> sum(const T* items, size_t count) noexcept
+        {
+            if constexpr (!Detail::has_simd_reduction_v<T>)
+            {
+                return Scalar::sum(items, count);
+            }
+            else
+            {
+                size_t i = 0;
+                sum_type_t<T> result{};
+
+                if constexpr (std::is_same_v<T, std::int32_t>)
+                {
+                    __m256i acc = _mm256_setzero_si256();
+                    for (; i + 4 <= count; i += 4)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+                        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(v));
+                    }
+
+                    alignas(32) std::int64_t lanes[4];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                    result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+                }
+                else if constexpr (std::is_same_v<T, float>)
+                {
+                    __m256 acc = _mm256_setzero_ps();
+                    for (; i + 8 <= count; i += 8)
+                        acc = _mm256_add_ps(acc, _mm256_loadu_ps(items + i));
+
+                    alignas(32) float lanes[8];
+                    _mm256_store_ps(lanes, acc);
+                    result = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+                }
+                else
+                {
+                    __m256d acc = _mm256_setzero_pd();
+                    for (; i + 4 <= count; i += 4)
+                        acc = _mm256_add_pd(acc, _mm256_loadu_pd(items + i));
+
+                    alignas(32) double lanes[4];
+                    _mm256_store_pd(lanes, acc);
+                    result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+                }
+
+                return result + Scalar::sum(items + i, count - i);
+            }
+        }
+
+        template <bool IsMax, Reducible T>
+        SIMD_TARGET_AVX2 T min_max(const T* items, size_t count) noexcept
+        {
+            if constexpr (!Detail::has_simd_reduction_v<T>)
+            {
+                return IsMax ? Scalar::max(items, count) : Scalar::min(items, count);
+            }
+            else
+            {
+                constexpr size_t items_per_register = 32 / sizeof(T);
+                if (count < items_per_register)
+                    return IsMax ? Scalar::max(items, count) : Scalar::min(items, count);
+
+                alignas(32) T lanes[items_per_register];
+                size_t i = items_per_register;
+
+                if constexpr (std::is_same_v<T, std::int32_t>)
+                {
+                    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+                    for (; i + items_per_register <= count; i += items_per_register)
+                    {
+                        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i));
+                        acc = IsMax ? _mm256_max_epi32(acc, v) : _mm256_min_epi32(acc, v);
+                    }
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                }
+                else if constexpr (std::is_same_v<T, float>)
+                {
+                    __m256 acc = _mm256_loadu_ps(items);
+                    for (; i + items_per_register <= count; i += items_per_register)
+                        acc = IsMax ? _mm256_max_ps(acc, _mm256_loadu_ps(items + i)) : _mm256_min_ps(acc, _mm256_loadu_ps(items + i));
+                    _mm256_store_ps(lanes, acc);
+                }
+                else
+                {
+                    __m256d acc = _mm256_loadu_pd(items);
+                    for (; i + items_per_register <= count; i += items_per_register)
+                        acc = IsMax ? _mm256_max_pd(acc, _mm256_loadu_pd(items + i)) : _mm256_min_pd(acc, _mm256_loadu_pd(items + i));
+                    _mm256_store_pd(lanes, acc);
+                }
+
+                T result = IsMax ? Scalar::max(lanes, items_per_register) : Scalar::min(lanes, items_per_register);
+                if (i < count)
+                {
+                    const T tail_result = IsMax ? Scalar::max(items + i, count - i) : Scalar::min(items + i, count - i);
+                    result = IsMax ? std::max(result, tail_result) : std::min(result, tail_result);
+                }
+
+                return result;
+            }
+        }
+
+        template <Reducible T>
+        SIMD_TARGET_AVX2 T min(const T* items, size_t count) noexcept
+        {
+            return min_max<false>(items, count);
+        }
+
+        template <Reducible T>
+        SIMD_TARGET_AVX2 T max(const T* items, size_t count) noexcept
+        {
+            return min_max<true>(items, count);
+        }
+    } // namespace Avx2
+#endif
+
+    inline InstructionSet detect_instruction_set() noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+        __cpuidex(info, 7, 0);
+        const bool has_avx2 = os_saves_ymm && (info[1] & (1 << 5));
+#else
+        const bool has_avx2 = __builtin_cpu_supports("avx2");
+#endif
+        return has_avx2 ? InstructionSet::AVX2 : InstructionSet::SSE2;
+#else
+        return InstructionSet::Scalar;
+#endif
+    }
+
+    inline InstructionSet instruction_set() noexcept
+    {
+        static const InstructionSet detected = detect_instruction_set();
+        return detected;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // dispatching functions
+
+    template <Vectorizable T>
+    bool equal(const T* a, const T* b, size_t count) noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+        if (instruction_set() == InstructionSet::AVX2)
+            return Avx2::equal(a, b, count);
+        return Sse2::equal(a, b, count);
+#else
+        return Scalar::equal(a, b, count);
+#endif
+    }
+
+    template <Vectorizable T>
+    void fill(T* dest, size_t count, T value) noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+        if (instruction_set() == InstructionSet::AVX2)
+            return Avx2::fill(dest, count, value);
+        return Sse2::fill(dest, count, value);
+#else
+        return Scalar::fill(dest, count, value);
+#endif
+    }
+
+    template <Vectorizable T>
+    size_t find(const T* items, size_t count, T value) noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+        if (instruction_set() == InstructionSet::AVX2)
+            return Avx2::find(items, count, value);
+        return Sse2::find(items, count, value);
+#else
+        return Scalar::find(items, count, value);
+#endif
+    }
+
+    template <Reducible T>
+    sum_type_t<T> sum(const T* items, size_t count) noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+        if (instruction_set() == InstructionSet::AVX2)
+            return Avx2::sum(items, count);
+        return Sse2::sum(items, count);
+#else
+        return Scalar::sum(items, count);
+#endif
+    }
+
+    template <Reducible T>
+    T min(const T* items, size_t count) noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+        if (instruction_set() == InstructionSet::AVX2)
+            return Avx2::min(items, count);
+        return Sse2::min(items, count);
+#else
+        return Scalar::min(items, count);
+#endif
+    }
+
+    template <Reducible T>
+    T max(const T* items, size_t count) noexcept
+    {
+#ifdef SIMD_KERNELS_X86_64
+        if (instruction_set() == InstructionSet::AVX2)
+            return Avx2::max(items, count);
+        return Sse2::max(items, count);
+#else
+        return Scalar::max(items, count);
+#endif
+    }
+} // namespace Simd
+
+#endif /*SIMD_KERNELS_HPP*/
@@ -0,0 +1,245 @@
+#include "memory_resources.hpp"
+#include "vectorlike.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Helpers::ArenaResource;
+using Helpers::PoolResource;
+
+namespace
+{
+    bool is_aligned(const void* ptr, size_t alignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+    }
+} // namespace
+
+TEST_CASE("ArenaResource")
+{
+    ArenaResource arena{1024};
+
+    SECTION("allocations are bumped inside a chunk")
+    {
+        void* ptr1 = arena.allocate(10, 1);
+        void* ptr2 = arena.allocate(10, 1);
+
+        CHECK(static_cast<std::byte*>(ptr2) == static_cast<std::byte*>(ptr1) + 10);
+        CHECK(arena.stats().chunks == 1);
+        CHECK(arena.stats().bytes_used == 20);
+    }
+
+    SECTION("alignment is respected")
+    {
+        CHECK(arena.allocate(1, 1) != nullptr);
+
+        CHECK(is_aligned(arena.allocate(8, 8), 8));
+        CHECK(is_aligned(arena.allocate(64, 64), 64));
+        CHECK(is_aligned(arena.allocate(16, 256), 256));
+    }
+
+    SECTION("new chunks are acquired when current one is exhausted")
+    {
+        CHECK(arena.allocate(1000, 1) != nullptr);
+        CHECK(arena.allocate(1000, 1) != nullptr);
+        CHECK(arena.allocate(10'000, 1) != nullptr);
+
+        const auto stats = arena.stats();
+        CHECK(stats.chunks == 3);
+        CHECK(stats.bytes_used == 12'000);
+        CHECK(stats.bytes_reserved >= 12'000);
+    }
+
+    SECTION("release returns all chunks - peak usage is kept")
+    {
+        CHECK(arena.allocate(5'000, 8) != nullptr);
+        arena.release();
+
+        const auto stats = arena.stats();
+        CHECK(stats.chunks == 0);
+        CHECK(stats.bytes_reserved == 0);
+        CHECK(stats.bytes_used == 0);
+        CHECK(stats.peak_bytes_used == 5'000);
+    }
+
+    SECTION("initial buffer is used before upstream")
+    {
+        std::byte buffer[256];
+        ArenaResource buffered_arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+        auto* ptr = static_cast<std::byte*>(buffered_arena.allocate(100, 4));
+
+        CHECK((ptr >= std::begin(buffer) && ptr < std::end(buffer)));
+        CHECK(buffered_arena.stats().chunks == 0);
+        CHECK_THROWS_AS(buffered_arena.allocate(1'000, 4), std::bad_alloc);
+    }
+
+    SECTION("containers")
+    {
+        pmr::Vector<std::pmr::string> words(&arena);
+        for (int i = 0; i < 100; ++i)
+            words.push_back(std::pmr::string(32, 'a' + i % 26));
+
+        CHECK(words.size() == 100);
+        CHECK(words[99].get_allocator().resource() == &arena);
+        CHECK(arena.stats().bytes_used > 100 * 32);
+    }
+}
+
+TEST_CASE("PoolResource")
+{
+    PoolResource pool;
+
+    SECTION("requests are rounded up to size classes")
+    {
+        CHECK(PoolResource::block_size_for(1, 1) == 8);
+        CHECK(PoolResource::block_size_for(24, 8) == 32);
+        CHECK(PoolResource::block_size_for(8, 64) == 64);
+    }
+
+    SECTION("deallocated blocks are reused")
+    {
+        void* ptr1 = pool.allocate(24, 8);
+        pool.deallocate(ptr1, 24, 8);
+        void* ptr2 = pool.allocate(20, 4); // the same size class
+
+        CHECK(ptr1 == ptr2);
+        CHECK(pool.stats().chunks == 1);
+    }
+
+    SECTION("blocks are aligned to requested alignment")
+    {
+        CHECK(is_aligned(pool.allocate(8, 8), 8));
+        CHECK(is_aligned(pool.allocate(24, 32), 32));
+        CHECK(is_aligned(pool.allocate(100, 128), 128));
+    }
+
+    SECTION("stats")
+    {
+        std::vector<void*> blocks;
+        for (int i = 0; i < 100; ++i)
+            blocks.push_back(pool.allocate(64, 8));
+
+        CHECK(pool.stats().bytes_used == 100 * 64);
+
+        for (void* block : blocks)
+            pool.deallocate(block, 64, 8);
+
+        const auto stats = pool.stats();
+        CHECK(stats.bytes_used == 0);
+        CHECK(stats.peak_bytes_used == 100 * 64);
+        CHECK(stats.chunks > 1);
+    }
+
+    SECTION("large requests are forwarded to upstream")
+    {
+        void* ptr = pool.allocate(100'000, 16);
+
+        CHECK(pool.stats().chunks == 0);
+        CHECK(pool.stats().bytes_used == 100'000);
+
+        pool.deallocate(ptr, 100'000, 16);
+        CHECK(pool.stats().bytes_used == 0);
+    }
+
+    SECTION("containers")
+    {
+        pmr::Vector<std::pmr::string> words(&pool);
+        for (int i = 0; i < 100; ++i)
+            words.push_back(std::pmr::string(32, 'a' + i % 26));
+
+        CHECK(words[99] == std::pmr::string(32, 'a' + 99 % 26));
+        CHECK(words[99].get_allocator().resource() == &pool);
+
+        words.clear();
+        words.shrink_to_fit();
+        CHECK(pool.stats().bytes_used == 0);
+    }
+}
+
+TEST_CASE("thread arenas")
+{
+    auto& registry = Helpers::ArenaRegistry::instance();
+
+    ArenaResource* main_arena = &Helpers::thread_arena();
+    CHECK(&Helpers::thread_arena() == main_arena);
+
+    const size_t peak_before = registry.total_stats().peak_bytes_used;
+
+    std::vector<ArenaResource*> arenas(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < arenas.size(); ++i)
+    {
+        threads.emplace_back([&arenas, i] {
+            ArenaResource& arena = Helpers::thread_arena();
+            arenas[i] = &arena;
+
+            pmr::Vector<int> vec(1'000, &arena);
+        });
+    }
+
+    for (auto& thd : threads)
+        thd.join();
+
+    CHECK(std::set<ArenaResource*>(arenas.begin(), arenas.end()).count(main_arena) == 0);
+    CHECK(registry.total_stats().peak_bytes_used >= peak_before + 4 * 1'000 * sizeof(int));
+    CHECK(registry.arena_count() >= 1);
+}
+
+TEST_CASE("memory resources - benchmark", "[.][benchmark]")
+{
+    constexpr int count = 10'000;
+
+    auto fill = [](std::pmr::memory_resource* resource) {
+        pmr::Vector<std::pmr::string> words(resource);
+        for (int i = 0; i < count; ++i)
+            words.emplace_back(48, 'x');
+
+        return words.size();
+    };
+
+    BENCHMARK("global new")
+    {
+        return fill(std::pmr::new_delete_resource());
+    };
+
+    BENCHMARK("std::pmr::monotonic_buffer_resource")
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        return fill(&resource);
+    };
+
+    BENCHMARK("Helpers::ArenaResource")
+    {
+        ArenaResource arena;
+        return fill(&arena);
+    };
+
+    BENCHMARK("std::pmr::unsynchronized_pool_resource")
+    {
+        std::pmr::unsynchronized_pool_resource resource;
+        return fill(&resource);
+    };
+
+    BENCHMARK("Helpers::PoolResource")
+    {
+        PoolResource pool;
+        return fill(&pool);
+    };
+
+    BENCHMARK("Helpers::thread_arena")
+    {
+        ArenaResource& arena = Helpers::thread_arena();
+        const size_t size = fill(&arena);
+        arena.release();
+
+        return size;
+    };
+}
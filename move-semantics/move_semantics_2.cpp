@@ -1,6 +1,13 @@
 #include "gadget.hpp"
+#include "relocatable.hpp"
+#include "vectorlike.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <string>
+#include <type_traits>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 ////////////////////////////////////////////////
@@ -9,67 +16,169 @@
 namespace Explain
 {
     template <typename T>
-    class unique_ptr
+    struct default_delete
     {
-    public:
-        unique_ptr() noexcept
-            : p_{nullptr}
-        { }
+        default_delete() = default;
 
-        unique_ptr(nullptr_t) noexcept
-            : p_{nullptr}
+        template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        default_delete(const default_delete<U>&) noexcept
         { }
 
-        explicit unique_ptr(T* ptr) noexcept
-            : p_{ptr}
-        { }
+        void operator()(T* ptr) const noexcept { delete ptr; }
+    };
 
-        unique_ptr(const unique_ptr& ptr) = delete;
-        unique_ptr& operator=(const unique_ptr& ptr) = delete;
+    template <typename T>
+    struct default_delete<T[]>
+    {
+        void operator()(T* ptr) const noexcept { delete[] ptr; }
+    };
 
-        unique_ptr(unique_ptr&& ptr) noexcept
-            : p_{std::exchange(ptr.p_, nullptr)}
-        { }
+    namespace Detail
+    {
+        // stateless deleter is a base class - empty base optimization makes it take no space
+        template <typename T, typename Deleter, bool = std::is_empty_v<Deleter> && !std::is_final_v<Deleter>>
+        class PointerWithDeleter : private Deleter
+        {
+        public:
+            PointerWithDeleter(T* ptr, Deleter deleter) noexcept
+                : Deleter(std::move(deleter)), p_{ptr}
+            { }
+
+            T*& pointer() noexcept { return p_; }
+            T* pointer() const noexcept { return p_; }
+
+            Deleter& deleter() noexcept { return *this; }
+            const Deleter& deleter() const noexcept { return *this; }
+
+        private:
+            T* p_;
+        };
+
+        // deleter with state (e.g. function pointer) is stored next to the pointer
+        template <typename T, typename Deleter>
+        class PointerWithDeleter<T, Deleter, false>
+        {
+        public:
+            PointerWithDeleter(T* ptr, Deleter deleter) noexcept
+                : p_{ptr}, deleter_(std::move(deleter))
+            { }
+
+            T*& pointer() noexcept { return p_; }
+            T* pointer() const noexcept { return p_; }
+
+            Deleter& deleter() noexcept { return deleter_; }
+            const Deleter& deleter() const noexcept { return deleter_; }
+
+        private:
+            T* p_;
+            Deleter deleter_;
+        };
+
+        // a value-initialized function pointer would be a null deleter - it has to be passed explicitly
+        template <typename Deleter>
+        concept DefaultDeleter = std::is_default_constructible_v<Deleter> && !std::is_pointer_v<Deleter>;
 
-        unique_ptr& operator=(unique_ptr&& ptr) noexcept
+        // ownership common for unique_ptr<T> & unique_ptr<T[]>
+        template <typename T, typename Deleter>
+        class UniqueOwner
         {
-            if (this != &ptr)
+        public:
+            UniqueOwner() noexcept
+                requires DefaultDeleter<Deleter>
+                : storage_{nullptr, Deleter{}}
+            { }
+
+            UniqueOwner(nullptr_t) noexcept
+                requires DefaultDeleter<Deleter>
+                : UniqueOwner()
+            { }
+
+            explicit UniqueOwner(T* ptr) noexcept
+                requires DefaultDeleter<Deleter>
+                : storage_{ptr, Deleter{}}
+            { }
+
+            UniqueOwner(T* ptr, Deleter deleter) noexcept
+                : storage_{ptr, std::move(deleter)}
+            { }
+
+            UniqueOwner(const UniqueOwner&) = delete;
+            UniqueOwner& operator=(const UniqueOwner&) = delete;
+
+            UniqueOwner(UniqueOwner&& other) noexcept
+                : storage_{other.release(), std::move(other.get_deleter())}
+            { }
+
+            UniqueOwner& operator=(UniqueOwner&& other) noexcept
             {
-                delete p_;
-                p_ = std::exchange(ptr.p_, nullptr);
+                if (this != &other)
+                {
+                    reset(other.release());
+                    get_deleter() = std::move(other.get_deleter());
+                }
+
+                return *this;
             }
 
-            return *this;
-        }
+            ~UniqueOwner() noexcept
+            {
+                reset();
+            }
 
-        ~unique_ptr() noexcept
-        {
-            delete p_;
-        }
+            T* get() const noexcept { return storage_.pointer(); }
 
-        T* get() const noexcept { return p_; } 
+            Deleter& get_deleter() noexcept { return storage_.deleter(); }
+            const Deleter& get_deleter() const noexcept { return storage_.deleter(); }
 
-        explicit operator bool() const noexcept
-        {
-            return p_ != nullptr;
-        }
+            [[nodiscard]] T* release() noexcept
+            {
+                return std::exchange(storage_.pointer(), nullptr);
+            }
 
-        bool operator==(const unique_ptr& rhs) const noexcept
-        {
-            return p_ == rhs.p_;
-        }
+            void reset(T* ptr = nullptr) noexcept
+            {
+                if (T* old = std::exchange(storage_.pointer(), ptr))
+                    get_deleter()(old);
+            }
 
-        bool operator!=(const unique_ptr& rhs) const noexcept
-        {
-            return !(*this == rhs);
-        }
+            explicit operator bool() const noexcept
+            {
+                return get() != nullptr;
+            }
 
-        T* operator->() const noexcept { return p_; }
+            bool operator==(const UniqueOwner& rhs) const noexcept
+            {
+                return get() == rhs.get();
+            }
+
+            bool operator!=(const UniqueOwner& rhs) const noexcept
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+            PointerWithDeleter<T, Deleter> storage_;
+        };
+    } // namespace Detail
 
-        T& operator*() const { return *p_; } 
+    template <typename T, typename Deleter = default_delete<T>>
+    class unique_ptr : public Detail::UniqueOwner<T, Deleter>
+    {
+    public:
+        using Detail::UniqueOwner<T, Deleter>::UniqueOwner;
+
+        T* operator->() const noexcept { return this->get(); }
 
-    private:
-        T* p_;
+        T& operator*() const { return *this->get(); }
+    };
+
+    template <typename T, typename Deleter>
+    class unique_ptr<T[], Deleter> : public Detail::UniqueOwner<T, Deleter>
+    {
+    public:
+        using Detail::UniqueOwner<T, Deleter>::UniqueOwner;
+
+        T& operator[](size_t index) const { return this->get()[index]; }
     };
 
     // template <typename T>
@@ -91,13 +200,43 @@ namespace Explain
     // }
 
     template <typename T, typename... TArgs>
+        requires (!std::is_array_v<T>)
     unique_ptr<T> make_unique(TArgs&&... args)
     {
         return unique_ptr<T>{new T(std::forward<TArgs>(args)...)};
     }
 
+    // items are value-initialized (zeroed for int)
+    template <typename T>
+        requires std::is_unbounded_array_v<T>
+    unique_ptr<T> make_unique(size_t size)
+    {
+        return unique_ptr<T>{new std::remove_extent_t<T>[size]()};
+    }
+
+    // default-initialization - trivial types are left uninitialized (buffers that will be overwritten anyway)
+    template <typename T>
+        requires (!std::is_array_v<T>)
+    unique_ptr<T> make_unique_for_overwrite()
+    {
+        return unique_ptr<T>{new T};
+    }
+
+    template <typename T>
+        requires std::is_unbounded_array_v<T>
+    unique_ptr<T> make_unique_for_overwrite(size_t size)
+    {
+        return unique_ptr<T>{new std::remove_extent_t<T>[size]};
+    }
+
 } // namespace Explain
 
+// unique_ptr holds only a raw pointer (and a deleter) - it can be relocated with memcpy
+template <typename T, typename Deleter>
+struct Helpers::is_trivially_relocatable<Explain::unique_ptr<T, Deleter>> : Helpers::is_trivially_relocatable<Deleter>
+{
+};
+
 Explain::unique_ptr<Helpers::Gadget> create_gadget(const std::string& name)
 {
     static int id_gen = 0;
@@ -176,6 +315,195 @@ TEST_CASE("move semantics - unique_ptr")
     }
 }
 
+namespace
+{
+    int* create_buffer(size_t size)
+    {
+        return static_cast<int*>(std::malloc(size * sizeof(int)));
+    }
+
+    void free_buffer(int* buffer)
+    {
+        std::free(buffer);
+    }
+
+    struct BufferDeleter
+    {
+        void operator()(int* buffer) const noexcept
+        {
+            free_buffer(buffer);
+        }
+    };
+} // namespace
+
+// stateless deleters cost nothing - only the deleter with state (function pointer) takes space
+static_assert(sizeof(Explain::unique_ptr<int>) == sizeof(int*));
+static_assert(sizeof(Explain::unique_ptr<int[]>) == sizeof(int*));
+static_assert(sizeof(Explain::unique_ptr<int[], BufferDeleter>) == sizeof(int*));
+static_assert(sizeof(Explain::unique_ptr<int[], decltype([](int* b) { free_buffer(b); })>) == sizeof(int*));
+static_assert(sizeof(Explain::unique_ptr<int[], void (*)(int*)>) == 2 * sizeof(int*));
+static_assert(!std::is_default_constructible_v<Explain::unique_ptr<int[], void (*)(int*)>>);
+static_assert(!std::is_constructible_v<Explain::unique_ptr<int[], void (*)(int*)>, int*>);
+static_assert(std::is_constructible_v<Explain::unique_ptr<int[], void (*)(int*)>, int*, void (*)(int*)>);
+
+TEST_CASE("move semantics - unique_ptr for arrays & custom deleters")
+{
+    SECTION("array - delete[] is used")
+    {
+        Explain::unique_ptr<int[]> buffer = Explain::make_unique<int[]>(1024);
+
+        CHECK(buffer[0] == 0);
+        CHECK(buffer[1023] == 0);
+
+        buffer[56] = 543;
+        CHECK(buffer.get()[56] == 543);
+    }
+
+    SECTION("array of objects")
+    {
+        Explain::unique_ptr<std::string[]> words = Explain::make_unique<std::string[]>(3);
+        words[0] = "unique";
+        words[2] = "ptr";
+
+        CHECK(words[1].empty());
+    }
+
+    SECTION("make_unique_for_overwrite - items are default-initialized")
+    {
+        Explain::unique_ptr<int[]> buffer = Explain::make_unique_for_overwrite<int[]>(1024);
+        std::fill_n(buffer.get(), 1024, 7);
+
+        CHECK(buffer[1023] == 7);
+
+        Explain::unique_ptr<int> value = Explain::make_unique_for_overwrite<int>();
+        *value = 42;
+        CHECK(*value == 42);
+    }
+
+    SECTION("custom deleter")
+    {
+        Explain::unique_ptr<int[], BufferDeleter> buffer{create_buffer(1024)};
+        buffer[56] = 543;
+
+        Explain::unique_ptr<int[], BufferDeleter> target = std::move(buffer);
+        CHECK_FALSE(buffer);
+        CHECK(target[56] == 543);
+    }
+
+    SECTION("function pointer as deleter")
+    {
+        Explain::unique_ptr<int[], void (*)(int*)> buffer{create_buffer(1024), &free_buffer};
+        CHECK(buffer.get_deleter() == &free_buffer);
+    }
+
+    SECTION("release & reset")
+    {
+        auto ptr = Explain::make_unique<int>(42);
+        int* raw = ptr.release();
+        CHECK_FALSE(ptr);
+
+        ptr.reset(raw);
+        CHECK(*ptr == 42);
+
+        ptr.reset();
+        CHECK(ptr == nullptr);
+    }
+}
+
+TEST_CASE("make_unique vs. make_unique_for_overwrite - benchmark", "[.][benchmark]")
+{
+    constexpr size_t size = 1'000'000;
+
+    BENCHMARK("make_unique<int[]> - value-initialized")
+    {
+        auto buffer = Explain::make_unique<int[]>(size);
+        buffer[size - 1] = 1;
+        return buffer[size - 1];
+    };
+
+    BENCHMARK("make_unique_for_overwrite<int[]>")
+    {
+        auto buffer = Explain::make_unique_for_overwrite<int[]>(size);
+        buffer[size - 1] = 1;
+        return buffer[size - 1];
+    };
+}
+
+TEST_CASE("Vector of unique_ptr - relocation")
+{
+    static_assert(Helpers::is_trivially_relocatable_v<Explain::unique_ptr<int>>);
+
+    Vector<Explain::unique_ptr<int>> vec;
+
+    for (int i = 0; i < 100; ++i)
+        vec.push_back(Explain::make_unique<int>(i));
+
+    vec.insert(vec.begin(), Explain::make_unique<int>(-1));
+    vec.erase(vec.begin() + 1, vec.begin() + 51);
+
+    REQUIRE(vec.size() == 51);
+    CHECK(*vec[0] == -1);
+    CHECK(*vec[1] == 50);
+    CHECK(*vec.back() == 99);
+}
+
+namespace
+{
+    // the same handle without the opt-in trait - relocated with a move constructor & destructor
+    struct NonRelocatableHandle
+    {
+        Explain::unique_ptr<int> ptr;
+    };
+
+    static_assert(!Helpers::is_trivially_relocatable_v<NonRelocatableHandle>);
+
+    template <typename Handle>
+    size_t fill_without_reserve(size_t count)
+    {
+        Vector<Handle> handles;
+
+        for (size_t i = 0; i < count; ++i)
+            handles.emplace_back();
+
+        return handles.size();
+    }
+
+    template <typename Handle>
+    size_t erase_from_front(Vector<Handle>& handles, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            handles.erase(handles.begin());
+
+        return handles.size();
+    }
+} // namespace
+
+TEST_CASE("Vector of move-only handles - relocation benchmark", "[.][benchmark]")
+{
+    constexpr size_t count = 10'000'000;
+
+    BENCHMARK("push_back - trivially relocatable")
+    {
+        return fill_without_reserve<Explain::unique_ptr<int>>(count);
+    };
+
+    BENCHMARK("push_back - move + destroy")
+    {
+        return fill_without_reserve<NonRelocatableHandle>(count);
+    };
+
+    BENCHMARK_ADVANCED("erase front - trivially relocatable")(Catch::Benchmark::Chronometer meter)
+    {
+        Vector<Explain::unique_ptr<int>> handles(count);
+        meter.measure([&] { return erase_from_front(handles, 10); });
+    };
+
+    BENCHMARK_ADVANCED("erase front - move assignment")(Catch::Benchmark::Chronometer meter)
+    {
+        Vector<NonRelocatableHandle> handles(count);
+        meter.measure([&] { return erase_from_front(handles, 10); });
+    };
+}
 
 template <typename... Ts>
 void foo(Ts... args)
@@ -1,7 +1,13 @@
 #include "helpers.hpp"
+#include "memory_resources.hpp"
+#include "relocatable.hpp"
 
+#include <cassert>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 
 ////////////////////////////////////////////////////////////////////////////
 // Data - class with copy & move semantics (user provided implementation)
@@ -10,7 +16,12 @@ using namespace Helpers;
 
 class Data
 {
-    std::string name_;
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+private:
+    allocator_type alloc_;
+    std::pmr::string name_;
     int* data_;
     size_t size_;
 
@@ -18,28 +29,37 @@ public:
     using iterator = int*;
     using const_iterator = const int*;
 
-    Data(std::string name, std::initializer_list<int> list)
-        : name_{std::move(name)}
+    Data(std::string_view name, std::initializer_list<int> list, const allocator_type& alloc = {})
+        : alloc_{alloc}
+        , name_{name, alloc}
         , size_{list.size()}
     {
-        data_ = new int[list.size()];
+        data_ = alloc_.allocate_object<int>(size_);
         std::copy(list.begin(), list.end(), data_);
 
         std::cout << "Data(" << name_ << ")\n";
     }
 
     Data(const Data& other)
-        : name_(other.name_)
+        : Data(other, allocator_type{})
+    {
+    }
+
+    // copy is placed in memory resource given by alloc
+    Data(const Data& other, const allocator_type& alloc)
+        : alloc_{alloc}
+        , name_(other.name_, alloc)
         , size_(other.size_)
     {
         std::cout << "Data(" << name_ << ": cc)\n";
-        data_ = new int[size_];
+        data_ = alloc_.allocate_object<int>(size_);
         std::copy(other.begin(), other.end(), data_);
     }
 
+    // memory resource of *this is not changed by assignment
     Data& operator=(const Data& other)
     {
-        Data temp(other);
+        Data temp(other, alloc_);
         swap(temp);
 
         std::cout << "Data=(" << name_ << ": cc)\n";
@@ -51,11 +71,19 @@ public:
 
     ~Data()
     {
-        delete[] data_;
+        alloc_.deallocate_object(data_, size_);
     }
 
+    allocator_type get_allocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    // both objects must use the same memory resource
     void swap(Data& other)
     {
+        assert(alloc_ == other.alloc_);
+
         name_.swap(other.name_);
         std::swap(data_, other.data_);
         std::swap(size_, other.size_);
@@ -82,6 +110,12 @@ public:
     }
 };
 
+// name_ is the only member that may refer to its own address
+template <>
+struct Helpers::is_trivially_relocatable<Data> : Helpers::is_trivially_relocatable<std::pmr::string>
+{
+};
+
 Data create_data_set()
 {
     Data ds{"data-set-one", {54, 6, 34, 235, 64356, 235, 23}};
@@ -95,4 +129,33 @@ TEST_CASE("Data & move semantics")
 
     Data backup = ds1; // copy
     Helpers::print(backup, "backup");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Data & memory resources")
+{
+    std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+    Data ds1{"a name long enough to be allocated in memory resource", {1, 2, 3}, &arena};
+    CHECK(ds1.get_allocator().resource() == &arena);
+
+    Data copy_in_default_resource = ds1;
+    CHECK(copy_in_default_resource.get_allocator().resource() == std::pmr::get_default_resource());
+
+    Data target{"target", {}, &arena};
+    target = copy_in_default_resource;
+    CHECK(target.get_allocator().resource() == &arena);
+    CHECK(std::equal(target.begin(), target.end(), ds1.begin(), ds1.end()));
+}
+
+TEST_CASE("Data & arena")
+{
+    ArenaResource arena;
+
+    {
+        Data ds1{"ds1", {1, 2, 3, 4, 5}, &arena};
+        Data ds2{ds1, &arena};
+    } // deallocation is no-op for arena
+
+    CHECK(arena.stats().bytes_used == 2 * 5 * sizeof(int));
+}
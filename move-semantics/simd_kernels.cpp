@@ -0,0 +1,200 @@
+#include "simd_kernels.hpp"
+#include "vectorlike.hpp"
+
+#include <algorithm>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    template <typename T>
+    std::vector<T> random_items(size_t count, unsigned seed)
+    {
+        std::mt19937_64 rnd{seed};
+        std::vector<T> items(count);
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            std::uniform_real_distribution<T> distribution{T(-1000), T(1000)};
+            std::generate(items.begin(), items.end(), [&] { return distribution(rnd); });
+        }
+        else
+        {
+            // range limited so that the sum of 64-bit items does not overflow
+            constexpr long long min_value = std::max<long long>(std::numeric_limits<T>::min(), -1'000'000'000);
+            constexpr long long max_value = std::min<long long>(std::numeric_limits<T>::max(), 1'000'000'000);
+            std::uniform_int_distribution<long long> distribution{min_value, max_value};
+            std::generate(items.begin(), items.end(), [&] { return static_cast<T>(distribution(rnd)); });
+        }
+
+        return items;
+    }
+
+    // sizes with and without tails left for scalar loops
+    constexpr size_t test_sizes[] = {0, 1, 3, 7, 8, 15, 16, 31, 33, 64, 1'000, 1'000'003};
+} // namespace
+
+TEMPLATE_TEST_CASE("SIMD kernels give the same results as scalar code", "[simd]", std::int8_t, std::uint16_t, std::int32_t, std::int64_t, float, double)
+{
+    using namespace Simd;
+
+    const size_t size = GENERATE(from_range(std::begin(test_sizes), std::end(test_sizes)));
+    const std::vector<TestType> items = random_items<TestType>(size, 665);
+
+    const auto check_kernels = [&](auto equal, auto fill, auto find, auto sum, auto min, auto max) {
+        SECTION("equal")
+        {
+            std::vector<TestType> copy = items;
+            CHECK(equal(items.data(), copy.data(), size) == Scalar::equal(items.data(), copy.data(), size));
+            CHECK(equal(items.data(), copy.data(), size));
+
+            if (size > 0)
+            {
+                copy[size / 2] += 1;
+                CHECK_FALSE(equal(items.data(), copy.data(), size));
+
+                copy = items;
+                copy.back() += 1;
+                CHECK_FALSE(equal(items.data(), copy.data(), size));
+            }
+        }
+
+        SECTION("fill")
+        {
+            std::vector<TestType> expected(size);
+            std::vector<TestType> filled(size);
+
+            Scalar::fill(expected.data(), size, TestType(42));
+            fill(filled.data(), size, TestType(42));
+
+            CHECK(filled == expected);
+        }
+
+        SECTION("find")
+        {
+            const auto expected_index = [&](TestType value) {
+                return static_cast<size_t>(std::find(items.begin(), items.end(), value) - items.begin());
+            };
+
+            for (size_t index : {size_t{0}, size / 2, size - 1})
+            {
+                if (index < size)
+                    CHECK(find(items.data(), size, items[index]) == expected_index(items[index]));
+            }
+
+            CHECK(find(items.data(), size, TestType(7)) == expected_index(TestType(7)));
+        }
+
+        SECTION("sum")
+        {
+            if constexpr (std::is_floating_point_v<TestType>)
+            {
+                // order of additions differs - both results must be within rounding error bound from exact sum
+                long double exact = 0.0L;
+                long double abs_sum = 0.0L;
+                for (auto x : items)
+                {
+                    exact += x;
+                    abs_sum += std::abs(x);
+                }
+                const long double error_bound = size * std::numeric_limits<TestType>::epsilon() * abs_sum;
+
+                CHECK(std::abs(sum(items.data(), size) - exact) <= error_bound);
+                CHECK(std::abs(Scalar::sum(items.data(), size) - exact) <= error_bound);
+            }
+            else
+                CHECK(sum(items.data(), size) == Scalar::sum(items.data(), size));
+        }
+
+        SECTION("min & max")
+        {
+            if (size > 0)
+            {
+                CHECK(min(items.data(), size) == Scalar::min(items.data(), size));
+                CHECK(max(items.data(), size) == Scalar::max(items.data(), size));
+                CHECK(min(items.data(), size) == *std::min_element(items.begin(), items.end()));
+                CHECK(max(items.data(), size) == *std::max_element(items.begin(), items.end()));
+            }
+        }
+    };
+
+#ifdef SIMD_KERNELS_X86_64
+    SECTION("SSE2")
+    {
+        check_kernels(
+            [](auto... args) { return Sse2::equal(args...); },
+            [](auto... args) { return Sse2::fill(args...); },
+            [](auto... args) { return Sse2::find(args...); },
+            [](auto... args) { return Sse2::sum(args...); },
+            [](auto... args) { return Sse2::min(args...); },
+            [](auto... args) { return Sse2::max(args...); });
+    }
+
+    SECTION("AVX2")
+    {
+        if (detect_instruction_set() == InstructionSet::AVX2)
+        {
+            check_kernels(
+                [](auto... args) { return Avx2::equal(args...); },
+                [](auto... args) { return Avx2::fill(args...); },
+                [](auto... args) { return Avx2::find(args...); },
+                [](auto... args) { return Avx2::sum(args...); },
+                [](auto... args) { return Avx2::min(args...); },
+                [](auto... args) { return Avx2::max(args...); });
+        }
+        else
+        {
+            WARN("AVX2 is not supported by CPU - kernels are not tested");
+        }
+    }
+#endif
+
+    SECTION("runtime dispatch")
+    {
+        check_kernels(
+            [](auto... args) { return Simd::equal(args...); },
+            [](auto... args) { return Simd::fill(args...); },
+            [](auto... args) { return Simd::find(args...); },
+            [](auto... args) { return Simd::sum(args...); },
+            [](auto... args) { return Simd::min(args...); },
+            [](auto... args) { return Simd::max(args...); });
+    }
+}
+
+TEST_CASE("Vector - vectorized operations")
+{
+    SECTION("operator==")
+    {
+        Vector<int> vec1(1'000'001, 7);
+        Vector<int> vec2(1'000'001, 7);
+        CHECK(vec1 == vec2);
+
+        vec2[1'000'000] = 8;
+        CHECK(vec1 != vec2);
+
+        CHECK(Vector<double>{0.0} == Vector<double>{-0.0}); // floating point comparison - not bitwise
+    }
+
+    SECTION("fill constructor")
+    {
+        Vector<short> vec(1'003, 42);
+        CHECK(std::all_of(vec.begin(), vec.end(), [](short x) { return x == 42; }));
+    }
+
+    SECTION("reductions")
+    {
+        Vector<int> vec = {3, -7, 12, 5, 0, 9, -2, 11, 4, 1};
+
+        CHECK(vec.sum() == 36);
+        CHECK(vec.min() == -7);
+        CHECK(vec.max() == 12);
+
+        Vector<int> large(1'000'000, 2'000'000'000);
+        CHECK(large.sum() == 2'000'000'000'000'000); // no overflow - 64-bit accumulator
+    }
+}
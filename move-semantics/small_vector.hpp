@@ -0,0 +1,548 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "relocatable.hpp"
+#include "vectorlike.hpp"
+
+////////////////////////////////////////////////////////////////////////////
+// SmallVector - up to N items are stored inline, heap is used only after that
+
+template <typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DefaultGrowth, typename TracingPolicy = DefaultTracing>
+class SmallVector
+{
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static_assert(N > 0, "inline capacity must be greater than 0");
+    static_assert(std::is_same_v<typename AllocatorTraits::value_type, T>, "Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename AllocatorTraits::pointer, T*>, "fancy pointers are not supported");
+
+    static constexpr bool is_nothrow_relocatable = Helpers::is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+    static constexpr bool propagate_on_copy = AllocatorTraits::propagate_on_container_copy_assignment::value;
+    static constexpr bool propagate_on_move = AllocatorTraits::propagate_on_container_move_assignment::value;
+    static constexpr bool propagate_on_swap = AllocatorTraits::propagate_on_container_swap::value;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static constexpr size_t inline_capacity = N;
+
+    SmallVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : SmallVector(Allocator())
+    { }
+
+    explicit SmallVector(const std::type_identity_t<Allocator>& alloc) noexcept
+        : alloc_{alloc}
+        , items_{inline_items()}
+        , size_{0}
+        , capacity_{N}
+    { }
+
+    explicit SmallVector(size_t size, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : SmallVector(alloc)
+    {
+        construct_items(size, [&] { std::uninitialized_value_construct_n(items_, size); });
+    }
+
+    SmallVector(size_t size, default_init_t, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : SmallVector(alloc)
+    {
+        construct_items(size, [&] { std::uninitialized_default_construct_n(items_, size); });
+    }
+
+    SmallVector(size_t size, const T& value, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : SmallVector(alloc)
+    {
+        construct_items(size, [&] { std::uninitialized_fill_n(items_, size, value); });
+    }
+
+    SmallVector(std::initializer_list<T> il, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : SmallVector(alloc)
+    {
+        construct_items(il.size(), [&] { std::uninitialized_copy(il.begin(), il.end(), items_); });
+    }
+
+    /* copy semantics */
+    SmallVector(const SmallVector& vec)
+        : SmallVector(vec, AllocatorTraits::select_on_container_copy_construction(vec.alloc_))
+    { }
+
+    SmallVector(const SmallVector& vec, const std::type_identity_t<Allocator>& alloc)
+        : SmallVector(alloc)
+    {
+        construct_items(vec.size(), [&] { std::uninitialized_copy(vec.begin(), vec.end(), items_); });
+        TracingPolicy::copy_constructed(*this);
+    }
+
+    SmallVector& operator=(const SmallVector& vec)
+    {
+        SmallVector temp(vec, propagate_on_copy ? vec.alloc_ : alloc_); // cc
+        reset();
+        if constexpr (propagate_on_copy)
+            alloc_ = temp.alloc_;
+        steal(temp);
+
+        TracingPolicy::copy_assigned(*this);
+
+        return *this;
+    }
+
+    /* move semantics - inline items have to be relocated one by one */
+    SmallVector(SmallVector&& vec) noexcept(is_nothrow_relocatable)
+        : SmallVector(std::move(vec.alloc_))
+    {
+        steal(vec);
+        TracingPolicy::move_constructed(*this);
+    }
+
+    SmallVector& operator=(SmallVector&& vec) noexcept(is_nothrow_relocatable && (propagate_on_move || AllocatorTraits::is_always_equal::value))
+    {
+        if (this != &vec)
+        {
+            replace_with(vec);
+            TracingPolicy::move_assigned(*this);
+        }
+
+        return *this;
+    }
+
+    void swap(SmallVector& vec) noexcept(is_nothrow_relocatable)
+    {
+        if (!is_inline() && !vec.is_inline() && (propagate_on_swap || alloc_ == vec.alloc_))
+        {
+            if constexpr (propagate_on_swap)
+                std::swap(alloc_, vec.alloc_);
+            std::swap(items_, vec.items_);
+            std::swap(size_, vec.size_);
+            std::swap(capacity_, vec.capacity_);
+
+            return;
+        }
+
+        SmallVector temp{vec.alloc_};
+        temp.steal(vec);
+        vec.replace_with(*this);
+        replace_with(temp);
+    }
+
+    ~SmallVector() noexcept
+    {
+        reset();
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    bool is_inline() const noexcept
+    {
+        return items_ == inline_items();
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    T* data() const noexcept
+    {
+        return items_;
+    }
+
+    reference operator[](size_t index)
+    {
+        return items_[index];
+    }
+
+    const_reference operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    reference back()
+    {
+        return items_[size_ - 1];
+    }
+
+    const_reference back() const
+    {
+        return items_[size_ - 1];
+    }
+
+    /* capacity management */
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+            reallocate(new_capacity);
+    }
+
+    // heap memory is released when all items fit into inline buffer
+    void shrink_to_fit()
+    {
+        if (is_inline() || capacity_ == size_)
+            return;
+
+        if (size_ <= N)
+        {
+            Helpers::uninitialized_relocate_n(items_, size_, inline_items());
+            deallocate(items_, capacity_);
+            items_ = inline_items();
+            capacity_ = N;
+        }
+        else
+        {
+            reallocate(size_);
+        }
+    }
+
+    /* modifiers */
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    template <typename... TArgs>
+    reference emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+            return emplace_back_with_reallocation(std::forward<TArgs>(args)...);
+
+        T* item = std::construct_at(items_ + size_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    template <typename... TArgs>
+    iterator emplace(const_iterator pos, TArgs&&... args)
+    {
+        const size_t index = pos - begin();
+
+        if (index == size_)
+        {
+            emplace_back(std::forward<TArgs>(args)...);
+            return items_ + index;
+        }
+
+        // new item is constructed first - args may refer to an element of this vector
+        T item(std::forward<TArgs>(args)...);
+
+        if (size_ == capacity_)
+            reallocate(GrowthPolicy::next_capacity(capacity_, size_ + 1));
+
+        T* gap = items_ + index;
+
+        if constexpr (Helpers::is_trivially_relocatable_v<T>)
+        {
+            Helpers::relocate_overlapping_n(gap, size_ - index, gap + 1);
+
+            try
+            {
+                std::construct_at(gap, std::move(item));
+            }
+            catch (...)
+            {
+                Helpers::relocate_overlapping_n(gap + 1, size_ - index, gap);
+                throw;
+            }
+
+            ++size_;
+        }
+        else
+        {
+            std::construct_at(items_ + size_, std::move(items_[size_ - 1]));
+            ++size_;
+
+            std::move_backward(gap, items_ + size_ - 2, items_ + size_ - 1);
+            *gap = std::move(item);
+        }
+
+        return gap;
+    }
+
+    iterator insert(const_iterator pos, const T& item)
+    {
+        return emplace(pos, item);
+    }
+
+    iterator insert(const_iterator pos, T&& item)
+    {
+        return emplace(pos, std::move(item));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        T* gap_first = items_ + (first - begin());
+        T* gap_last = items_ + (last - begin());
+
+        if constexpr (Helpers::is_trivially_relocatable_v<T>)
+        {
+            std::destroy(gap_first, gap_last);
+            Helpers::relocate_overlapping_n(gap_last, end() - gap_last, gap_first);
+        }
+        else
+        {
+            T* new_end = std::move(gap_last, end(), gap_first);
+            std::destroy(new_end, end());
+        }
+
+        size_ -= gap_last - gap_first;
+
+        return gap_first;
+    }
+
+    void pop_back() noexcept
+    {
+        std::destroy_at(items_ + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(items_, size_);
+        size_ = 0;
+    }
+
+    bool operator==(const SmallVector& rhs) const noexcept
+    {
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    bool operator!=(const SmallVector& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    iterator begin() noexcept
+    {
+        return items_;
+    }
+
+    iterator end() noexcept
+    {
+        return items_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return items_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items_ + size_;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SmallVector& vec)
+    {
+        out << "{ ";
+        for (const auto& item : vec)
+        {
+            out << item << " ";
+        }
+        out << "}";
+
+        return out;
+    }
+
+private:
+    [[no_unique_address]] Allocator alloc_;
+    T* items_;
+    size_t size_;
+    size_t capacity_;
+    alignas(T) std::byte inline_buffer_[N * sizeof(T)];
+
+    T* inline_items() const noexcept
+    {
+        return const_cast<T*>(reinterpret_cast<const T*>(inline_buffer_));
+    }
+
+    T* allocate(size_t capacity)
+    {
+        return AllocatorTraits::allocate(alloc_, capacity);
+    }
+
+    void deallocate(T* items, size_t capacity) noexcept
+    {
+        AllocatorTraits::deallocate(alloc_, items, capacity);
+    }
+
+    // *this must be empty with inline storage
+    template <typename Constructor>
+    void construct_items(size_t count, Constructor construct)
+    {
+        if (count > N)
+        {
+            items_ = allocate(count);
+            capacity_ = count;
+        }
+
+        try
+        {
+            construct();
+        }
+        catch (...)
+        {
+            reset();
+            throw;
+        }
+
+        size_ = count;
+    }
+
+    // *this must be empty with inline storage
+    // heap buffer is stolen only when it can be released by alloc_ - otherwise items are relocated one by one
+    void steal(SmallVector& vec) noexcept(is_nothrow_relocatable)
+    {
+        if (vec.is_inline() || !(AllocatorTraits::is_always_equal::value || alloc_ == vec.alloc_))
+        {
+            if (vec.size_ > N)
+            {
+                items_ = allocate(vec.size_);
+                capacity_ = vec.size_;
+            }
+
+            if constexpr (is_nothrow_relocatable)
+            {
+                Helpers::uninitialized_relocate_n(vec.items_, vec.size_, items_);
+            }
+            else
+            {
+                try
+                {
+                    Helpers::uninitialized_relocate_n(vec.items_, vec.size_, items_);
+                }
+                catch (...)
+                {
+                    reset(); // *this is still empty - only the new heap buffer is released
+                    throw;
+                }
+            }
+
+            size_ = std::exchange(vec.size_, 0);
+        }
+        else
+        {
+            items_ = std::exchange(vec.items_, vec.inline_items());
+            size_ = std::exchange(vec.size_, 0);
+            capacity_ = std::exchange(vec.capacity_, N);
+        }
+    }
+
+    // items of vec replace content of *this
+    void replace_with(SmallVector& vec) noexcept(is_nothrow_relocatable && (propagate_on_move || AllocatorTraits::is_always_equal::value))
+    {
+        reset();
+        if constexpr (propagate_on_move)
+            alloc_ = vec.alloc_;
+        steal(vec);
+    }
+
+    void reset() noexcept
+    {
+        std::destroy_n(items_, size_);
+        if (!is_inline())
+            deallocate(items_, capacity_);
+
+        items_ = inline_items();
+        size_ = 0;
+        capacity_ = N;
+    }
+
+    void reallocate(size_t new_capacity)
+    {
+        T* new_items = allocate(new_capacity);
+
+        try
+        {
+            Helpers::uninitialized_relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        replace_storage(new_items, new_capacity);
+    }
+
+    template <typename... TArgs>
+    reference emplace_back_with_reallocation(TArgs&&... args)
+    {
+        const size_t new_capacity = GrowthPolicy::next_capacity(capacity_, size_ + 1);
+        T* new_items = allocate(new_capacity);
+
+        // new item is constructed first - args may refer to an element of this vector
+        T* item = nullptr;
+        try
+        {
+            item = std::construct_at(new_items + size_, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        try
+        {
+            Helpers::uninitialized_relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            std::destroy_at(item);
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        replace_storage(new_items, new_capacity);
+        ++size_;
+
+        return *item;
+    }
+
+    // items_ must already be relocated to new_items
+    void replace_storage(T* new_items, size_t new_capacity) noexcept
+    {
+        if (!is_inline())
+            deallocate(items_, capacity_);
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+    }
+};
+
+#endif /*SMALL_VECTOR_HPP*/
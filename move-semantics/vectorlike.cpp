@@ -1,152 +1,16 @@
+#include "vectorlike.hpp"
+#include "memory_resources.hpp"
+#include "small_vector.hpp"
+
 #include <algorithm>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
 #include <utility>
-
-template<typename T = int>
-class Vector
-{
-public:
-    using iterator = T*;
-    using const_iterator = const T*;
-    using reference = T&;
-    using const_reference = const T&;
-    using value_type = T;
-
-    Vector() noexcept
-        : items_{nullptr}
-        , size_{0}
-    { }
-
-    explicit Vector(size_t size)
-        : items_{new T[size]}
-        , size_{size}
-    {
-        std::fill(items_, items_ + size_, 0);
-    }
-
-    Vector(std::initializer_list<T> il)
-        : items_{new T[il.size()]}
-        , size_{il.size()}
-    {
-        std::copy(il.begin(), il.end(), items_);
-    }
-
-    /* copy semantics */
-    Vector(const Vector& vec)
-        : items_{new T[vec.size()]}
-        , size_{vec.size()}
-    {
-        std::copy(vec.begin(), vec.end(), items_);
-        std::cout << "Vector(cc: " << *this << ")\n";
-    }
-
-    Vector& operator=(const Vector& vec)
-    {
-        Vector temp{vec}; // cc
-        swap(temp);
-
-        return *this;
-    }
-
-    /* move semantics */
-    Vector(Vector&& vec) noexcept
-        : items_{std::exchange(vec.items_, nullptr)}
-        , size_{std::exchange(vec.size_, 0)}
-    {
-        std::cout << "Vector(mv: " << *this << ")\n";
-    }
-
-    Vector& operator=(Vector&& vec) noexcept
-    {
-        if (this != &vec)
-        {
-            Vector temp{std::move(vec)}; // mv
-            swap(temp);            
-
-            std::cout << "Vector(mv: " << *this << ")\n";
-        }
-
-        return *this;
-    }
-
-    void swap(Vector& vec) noexcept
-    {
-        std::swap(items_, vec.items_);
-        std::swap(size_, vec.size_);
-    }
-
-    ~Vector() noexcept
-    {
-        delete[] items_;
-    }
-
-    size_t size() const noexcept
-    {
-        return size_;
-    }
-
-    T* data() const noexcept
-    {
-        return items_;
-    }
-
-    reference operator[](size_t index)
-    {
-        return items_[index]; // *(items_ + index)
-    }
-
-    const_reference operator[](size_t index) const
-    {
-        return items_[index];
-    }
-
-    bool operator==(const Vector& rhs) const noexcept
-    {
-        return std::equal(begin(), end(), rhs.begin(), rhs.end());
-    }
-
-    bool operator!=(const Vector& rhs) const noexcept
-    {
-        return !(*this == rhs);
-    }
-
-    iterator begin() noexcept
-    {
-        return items_;
-    }
-
-    iterator end() noexcept
-    {
-        return items_ + size_;
-    }
-
-    const_iterator begin() const noexcept 
-    {
-        return items_;
-    }
-
-    const_iterator end() const noexcept
-    {
-        return items_ + size_;
-    }
-
-    friend std::ostream& operator<<(std::ostream& out, const Vector& vec)
-    {
-        out << "{ ";
-        for (const auto& item : vec)
-        {
-            out << item << " ";
-        }
-        out << "}";
-
-        return out;
-    }
-
-private:
-    T* items_ = nullptr;
-    size_t size_{};
-};
+#include <vector>
 
 Vector<int> create_large_vec()
 {
@@ -266,30 +130,81 @@ TEST_CASE("Vector")
 
     SECTION("noexcept")
     {
-        std::vector<Vector<int>> vec;
+        using TracedVector = Vector<int, std::allocator<int>, DefaultGrowth, CountingTracing>;
+        CountingTracing::reset();
 
-        vec.push_back(Vector{1});
+        std::vector<TracedVector> vec;
 
-        std::cout << "--------------------\n";
+        vec.push_back(TracedVector{1});
+        vec.push_back(TracedVector{1, 2});
+        vec.push_back(TracedVector{1, 2, 3});
+        vec.push_back(TracedVector{1, 2, 3, 4});
+        vec.push_back(TracedVector{1, 2, 3, 4, 5});
+        vec.push_back(TracedVector{1, 2, 3, 4, 5, 6});
 
-        vec.push_back(Vector{1, 2});
+        CHECK(CountingTracing::copy_constructions == 0); // reallocation of std::vector moves noexcept items
+        CHECK(CountingTracing::move_constructions > 6);
+    }
+}
 
-        std::cout << "--------------------\n";
+TEST_CASE("Vector - tracing policy")
+{
+    using TracedVector = Vector<int, std::allocator<int>, DefaultGrowth, CountingTracing>;
+    CountingTracing::reset();
 
-        vec.push_back(Vector{1, 2, 3});
+    TracedVector vec1 = {1, 2, 3};
 
-        std::cout << "--------------------\n";
+    SECTION("copy constructor")
+    {
+        TracedVector vec2 = vec1;
 
-        vec.push_back(Vector{1, 2, 3, 4});
+        CHECK(CountingTracing::copy_constructions == 1);
+        CHECK(CountingTracing::move_constructions == 0);
+    }
 
-        std::cout << "--------------------\n";
+    SECTION("copy assignment - copy & swap")
+    {
+        TracedVector vec2;
+        vec2 = vec1;
 
-        vec.push_back(Vector{1, 2, 3, 4, 5});
+        CHECK(CountingTracing::copy_assignments == 1);
+        CHECK(CountingTracing::copy_constructions == 1);
+    }
 
-        std::cout << "--------------------\n";
+    SECTION("move constructor")
+    {
+        TracedVector vec2 = std::move(vec1);
 
-        vec.push_back(Vector{1, 2, 3, 4, 5, 6});
+        CHECK(CountingTracing::move_constructions == 1);
+        CHECK(CountingTracing::copy_constructions == 0);
+    }
+
+    SECTION("move assignment")
+    {
+        TracedVector vec2;
+        vec2 = std::move(vec1);
 
+        CHECK(CountingTracing::move_assignments == 1);
+        CHECK(CountingTracing::copy_constructions == 0);
+    }
+
+    SECTION("returning by value")
+    {
+        auto create = [] {
+            TracedVector vec(1'000'000);
+            return vec;
+        };
+
+        TracedVector vec2 = create();
+
+        CHECK(CountingTracing::copy_constructions == 0);
+        CHECK(CountingTracing::move_constructions <= 1);
+    }
+
+    SECTION("default policy has no state")
+    {
+        static_assert(std::is_empty_v<NoTracing>);
+        static_assert(sizeof(Vector<int, std::allocator<int>, DefaultGrowth, NoTracing>) == sizeof(TracedVector));
     }
 }
 
@@ -313,6 +228,637 @@ TEST_CASE("Vector - indexing")
     print(vec);
 }
 
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    inline static size_t allocations{};
+    inline static size_t deallocations{};
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept
+    { }
+
+    T* allocate(size_t n)
+    {
+        ++allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        ++deallocations;
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    friend bool operator==(const CountingAllocator&, const CountingAllocator&) = default;
+};
+
+TEST_CASE("Vector - construction of items")
+{
+    SECTION("value-initialized")
+    {
+        Vector<double> vec(5);
+
+        CHECK(std::all_of(vec.begin(), vec.end(), [](double x) { return x == 0.0; }));
+    }
+
+    SECTION("default-initialized - no zeroing")
+    {
+        Vector<int> vec(5, default_init);
+        CHECK(vec.size() == 5);
+
+        Vector<std::string> words(3, default_init);
+        CHECK(words == Vector<std::string>{"", "", ""});
+    }
+
+    SECTION("filled with value")
+    {
+        Vector vec(4, 42);
+        CHECK(vec == Vector{42, 42, 42, 42});
+
+        Vector<std::string> words(2, "abc");
+        CHECK(words == Vector<std::string>{"abc", "abc"});
+    }
+
+    SECTION("types not convertible from 0")
+    {
+        struct Point
+        {
+            int x = 1, y = 2;
+
+            bool operator==(const Point&) const = default;
+        };
+
+        Vector<Point> points(3);
+        CHECK(points[2] == Point{1, 2});
+    }
+
+    SECTION("memory is provided by an allocator")
+    {
+        using Alloc = CountingAllocator<int>;
+        Alloc::allocations = Alloc::deallocations = 0;
+
+        {
+            Vector<int, Alloc> vec(100, 1);
+            vec.push_back(2);
+            CHECK(vec.get_allocator() == Alloc{});
+        }
+
+        CHECK(Alloc::allocations == 2);
+        CHECK(Alloc::deallocations == 2);
+    }
+}
+
+TEST_CASE("Vector - capacity & growth")
+{
+    SECTION("default constructed vector has no capacity")
+    {
+        Vector<int> vec;
+        CHECK(vec.capacity() == 0);
+        CHECK(vec.empty());
+    }
+
+    SECTION("push_back")
+    {
+        Vector<int> vec;
+
+        vec.push_back(1);
+        vec.push_back(2);
+        vec.push_back(3);
+
+        CHECK(vec == Vector{1, 2, 3});
+        CHECK(vec.capacity() >= vec.size());
+    }
+
+    SECTION("geometric growth - amortized O(1) appends")
+    {
+        Vector<int> vec;
+        size_t reallocations = 0;
+        size_t last_capacity = vec.capacity();
+
+        for (int i = 0; i < 1024; ++i)
+        {
+            vec.push_back(i);
+            if (vec.capacity() != last_capacity)
+            {
+                ++reallocations;
+                last_capacity = vec.capacity();
+            }
+        }
+
+        CHECK(vec.size() == 1024);
+        CHECK(vec.capacity() == 1024);
+        CHECK(reallocations == 11);
+    }
+
+    SECTION("custom growth policy")
+    {
+        Vector<int, std::allocator<int>, GeometricGrowth<3, 2>> vec;
+
+        for (int i = 0; i < 4; ++i)
+            vec.push_back(i);
+
+        CHECK(vec.capacity() == 4); // 1 -> 2 -> 3 -> 4
+
+        vec.push_back(4);
+        CHECK(vec.capacity() == 6);
+    }
+
+    SECTION("push_back of an own element during reallocation")
+    {
+        Vector<std::string> words = {"one", "two"};
+        REQUIRE(words.size() == words.capacity());
+
+        words.push_back(words[0]);
+
+        CHECK(words.size() == 3);
+        CHECK(words[2] == "one");
+    }
+
+    SECTION("emplace_back")
+    {
+        Vector<std::string> words;
+
+        std::string& word = words.emplace_back(3, 'a');
+
+        CHECK(word == "aaa");
+        CHECK(&word == &words.back());
+    }
+
+    SECTION("move-only items")
+    {
+        Vector<std::unique_ptr<int>> ptrs;
+
+        for (int i = 0; i < 10; ++i)
+            ptrs.push_back(std::make_unique<int>(i));
+
+        CHECK(ptrs.size() == 10);
+        CHECK(*ptrs[9] == 9);
+    }
+
+    SECTION("copyable items with throwing move are copied")
+    {
+        struct Gadget
+        {
+            std::string name;
+
+            explicit Gadget(std::string n)
+                : name{std::move(n)}
+            { }
+
+            Gadget(const Gadget&) = default;
+            Gadget& operator=(const Gadget&) = default;
+
+            Gadget(Gadget&& other) noexcept(false)
+                : name{std::move(other.name)}
+            { }
+
+            Gadget& operator=(Gadget&&) = default;
+        };
+
+        static_assert(!std::is_nothrow_move_constructible_v<Gadget>);
+
+        Vector<Gadget> gadgets;
+        for (int i = 0; i < 10; ++i)
+            gadgets.push_back(Gadget{std::to_string(i)});
+        gadgets.reserve(100);
+
+        SmallVector<Gadget, 2> small_gadgets;
+        for (int i = 0; i < 10; ++i)
+            small_gadgets.emplace_back(std::to_string(i));
+
+        CHECK(gadgets.size() == 10);
+        CHECK(gadgets[0].name == "0");
+        CHECK(gadgets[9].name == "9");
+        CHECK(small_gadgets[0].name == "0");
+        CHECK(small_gadgets[9].name == "9");
+    }
+
+    SECTION("reserve")
+    {
+        Vector<int> vec = {1, 2, 3};
+
+        vec.reserve(100);
+        CHECK(vec.capacity() == 100);
+        CHECK(vec == Vector{1, 2, 3});
+
+        int* data = vec.data();
+        for (int i = 0; i < 97; ++i)
+            vec.push_back(i);
+        CHECK(vec.data() == data);
+
+        vec.reserve(10);
+        CHECK(vec.capacity() == 100);
+    }
+
+    SECTION("shrink_to_fit")
+    {
+        Vector<int> vec;
+        vec.reserve(100);
+        vec.push_back(1);
+        vec.push_back(2);
+
+        vec.shrink_to_fit();
+
+        CHECK(vec.capacity() == 2);
+        CHECK(vec == Vector{1, 2});
+    }
+
+    SECTION("pop_back & clear")
+    {
+        Vector<int> vec = {1, 2, 3};
+
+        vec.pop_back();
+        CHECK(vec == Vector{1, 2});
+
+        vec.clear();
+        CHECK(vec.empty());
+        CHECK(vec.capacity() == 3);
+    }
+}
+
+TEST_CASE("Vector - insert & erase")
+{
+    SECTION("trivially relocatable items")
+    {
+        static_assert(Helpers::is_trivially_relocatable_v<int>);
+
+        Vector<int> vec = {1, 2, 4};
+
+        auto pos = vec.insert(vec.begin() + 2, 3);
+        CHECK(*pos == 3);
+        CHECK(vec == Vector{1, 2, 3, 4});
+
+        vec.insert(vec.begin(), vec[3]);
+        CHECK(vec == Vector{4, 1, 2, 3, 4});
+
+        pos = vec.erase(vec.begin() + 1, vec.begin() + 3);
+        CHECK(*pos == 3);
+        CHECK(vec == Vector{4, 3, 4});
+
+        vec.erase(vec.begin());
+        CHECK(vec == Vector{3, 4});
+    }
+
+    SECTION("items relocated with move constructor")
+    {
+        static_assert(!Helpers::is_trivially_relocatable_v<std::string>);
+
+        Vector<std::string> words = {"one", "three"};
+
+        words.insert(words.begin() + 1, "two");
+        words.insert(words.end(), "four");
+        CHECK(words == Vector<std::string>{"one", "two", "three", "four"});
+
+        words.insert(words.begin(), words[2]);
+        CHECK(words == Vector<std::string>{"three", "one", "two", "three", "four"});
+
+        words.erase(words.begin(), words.begin() + 2);
+        CHECK(words == Vector<std::string>{"two", "three", "four"});
+    }
+
+    SECTION("nested vectors are relocated with memcpy")
+    {
+        static_assert(Helpers::is_trivially_relocatable_v<Vector<int>>);
+
+        Vector<Vector<int>> vecs;
+        vecs.emplace_back(3, 1);
+        vecs.emplace_back(2, 2);
+        vecs.emplace(vecs.begin(), 1, 0);
+
+        CHECK(vecs[0] == Vector{0});
+        CHECK(vecs[1] == Vector{1, 1, 1});
+        CHECK(vecs[2] == Vector{2, 2});
+    }
+}
+
+TEMPLATE_TEST_CASE("vector-like containers", "[vector][small_vector]", (Vector<int>), (SmallVector<int, 8>), (SmallVector<int, 2>))
+{
+    SECTION("default construction")
+    {
+        TestType vec;
+        CHECK(vec.size() == 0);
+        CHECK(vec.begin() == vec.end());
+    }
+
+    SECTION("constructor with given size")
+    {
+        TestType vec(5);
+        CHECK(vec.size() == 5);
+        CHECK(std::all_of(vec.begin(), vec.end(), [](int x) { return x == 0; }));
+    }
+
+    SECTION("constructor with initializer_list")
+    {
+        TestType vec = {1, 2, 3};
+        CHECK(vec.size() == 3);
+        CHECK(vec == TestType{1, 2, 3});
+        CHECK(vec != TestType{1, 2, 3, 4});
+    }
+
+    SECTION("push_back")
+    {
+        TestType vec;
+        for (int i = 0; i < 20; ++i)
+            vec.push_back(i);
+
+        CHECK(vec.size() == 20);
+        CHECK(vec[19] == 19);
+        CHECK(vec.capacity() >= vec.size());
+    }
+
+    SECTION("copy semantics")
+    {
+        TestType vec1 = {1, 2, 3};
+        TestType vec2 = vec1;
+        CHECK(vec1 == vec2);
+
+        TestType vec3 = {4, 5};
+        vec3 = vec1;
+        CHECK(vec3 == vec1);
+    }
+
+    SECTION("move semantics")
+    {
+        TestType vec1 = {1, 2, 3};
+        TestType vec2 = std::move(vec1);
+
+        CHECK(vec2 == TestType{1, 2, 3});
+        CHECK(vec1.empty());
+
+        TestType vec3 = {665, 667};
+        vec3 = std::move(vec2);
+        CHECK(vec3 == TestType{1, 2, 3});
+        CHECK(vec2.empty());
+    }
+
+    SECTION("swap")
+    {
+        TestType vec1 = {1, 2, 3};
+        TestType vec2 = {665, 667};
+
+        vec1.swap(vec2);
+
+        CHECK(vec1 == TestType{665, 667});
+        CHECK(vec2 == TestType{1, 2, 3});
+    }
+
+    SECTION("insert & erase")
+    {
+        TestType vec = {1, 2, 4};
+
+        auto pos = vec.insert(vec.begin() + 2, 3);
+        CHECK(*pos == 3);
+        vec.insert(vec.end(), 5);
+        vec.insert(vec.begin(), vec[4]);
+        CHECK(vec == TestType{5, 1, 2, 3, 4, 5});
+
+        pos = vec.erase(vec.begin() + 1, vec.begin() + 3);
+        CHECK(*pos == 3);
+        vec.erase(vec.begin());
+        CHECK(vec == TestType{3, 4, 5});
+    }
+
+    SECTION("iterators")
+    {
+        TestType vec = {3, 1, 2};
+        std::sort(vec.begin(), vec.end());
+
+        const TestType& cvec = vec;
+        CHECK(std::is_sorted(cvec.begin(), cvec.end()));
+        CHECK(cvec.end() - cvec.begin() == 3);
+    }
+}
+
+namespace
+{
+    // copy throws after copies_left copies, move is not noexcept - items are relocated by copying
+    struct Fragile
+    {
+        inline static int copies_left = 0;
+
+        int value;
+
+        Fragile(int v)
+            : value{v}
+        { }
+
+        Fragile(const Fragile& other)
+            : value{other.value}
+        {
+            if (copies_left-- == 0)
+                throw std::runtime_error{"copy failed"};
+        }
+
+        Fragile& operator=(const Fragile&) = default;
+
+        Fragile(Fragile&& other) noexcept(false)
+            : Fragile(static_cast<const Fragile&>(other))
+        { }
+    };
+} // namespace
+
+TEST_CASE("SmallVector")
+{
+    using Alloc = CountingAllocator<std::string>;
+
+    SECTION("up to N items are stored inline")
+    {
+        Alloc::allocations = 0;
+
+        SmallVector<std::string, 4, Alloc> words = {"one", "two", "three"};
+        words.push_back("four");
+
+        CHECK(words.is_inline());
+        CHECK(words.capacity() == 4);
+        CHECK(Alloc::allocations == 0);
+    }
+
+    SECTION("spills to heap after N items")
+    {
+        SmallVector<std::string, 2> words = {"one", "two"};
+        words.push_back("three");
+
+        CHECK_FALSE(words.is_inline());
+        CHECK(words == SmallVector<std::string, 2>{"one", "two", "three"});
+
+        SECTION("shrink_to_fit moves items back to inline buffer")
+        {
+            words.pop_back();
+            words.shrink_to_fit();
+
+            CHECK(words.is_inline());
+            CHECK(words == SmallVector<std::string, 2>{"one", "two"});
+        }
+    }
+
+    SECTION("moving inline items")
+    {
+        SmallVector<std::unique_ptr<int>, 4> ptrs;
+        ptrs.push_back(std::make_unique<int>(1));
+        ptrs.push_back(std::make_unique<int>(2));
+
+        auto target = std::move(ptrs);
+
+        CHECK(target.is_inline());
+        CHECK(*target[1] == 2);
+        CHECK(ptrs.empty());
+    }
+
+    SECTION("insert & erase of items relocated with move constructor")
+    {
+        SmallVector<std::string, 3> words = {"one", "three"};
+
+        words.insert(words.begin() + 1, "two");
+        CHECK(words.is_inline());
+
+        words.emplace(words.begin(), 4, 'x');
+        CHECK_FALSE(words.is_inline());
+        CHECK(words == SmallVector<std::string, 3>{"xxxx", "one", "two", "three"});
+
+        words.erase(words.begin(), words.begin() + 2);
+        CHECK(words == SmallVector<std::string, 3>{"two", "three"});
+    }
+
+    SECTION("heap buffer is released when relocation of items throws")
+    {
+        using FragileVector = SmallVector<Fragile, 2, std::pmr::polymorphic_allocator<Fragile>>;
+
+        Fragile::copies_left = 3;
+        FragileVector source({1, 2, 3});
+
+        Helpers::PoolResource pool;
+        FragileVector target(&pool);
+
+        Fragile::copies_left = 1;
+        CHECK_THROWS_AS(target = std::move(source), std::runtime_error); // resources differ - items are copied
+
+        CHECK(target.empty());
+        CHECK(pool.stats().bytes_used == 0);
+        CHECK(source.size() == 3);
+    }
+
+    SECTION("tracing policy")
+    {
+        using TracedSmallVector = SmallVector<int, 2, std::allocator<int>, DefaultGrowth, CountingTracing>;
+        CountingTracing::reset();
+
+        TracedSmallVector vec1 = {1, 2, 3};
+        TracedSmallVector vec2 = vec1;
+        vec2 = vec1;
+        TracedSmallVector vec3 = std::move(vec1);
+        vec3 = std::move(vec2);
+        vec1.swap(vec3);
+
+        CHECK(CountingTracing::copy_constructions == 2);
+        CHECK(CountingTracing::copy_assignments == 1);
+        CHECK(CountingTracing::move_constructions == 1);
+        CHECK(CountingTracing::move_assignments == 1);
+    }
+
+    SECTION("swap of inline & heap storage")
+    {
+        SmallVector<std::string, 2> small = {"a"};
+        SmallVector<std::string, 2> large = {"b", "c", "d"};
+
+        small.swap(large);
+
+        CHECK(small == SmallVector<std::string, 2>{"b", "c", "d"});
+        CHECK(large == SmallVector<std::string, 2>{"a"});
+        CHECK(large.is_inline());
+    }
+}
+
+TEST_CASE("Vector - polymorphic allocators")
+{
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+    SECTION("memory is acquired from given resource")
+    {
+        pmr::Vector<int> vec({1, 2, 3}, &arena);
+        vec.push_back(4);
+
+        CHECK(vec.get_allocator().resource() == &arena);
+        const auto* address = reinterpret_cast<const std::byte*>(vec.data());
+        CHECK((address >= std::begin(buffer) && address < std::end(buffer)));
+    }
+
+    SECTION("allocator-aware items use allocator of container")
+    {
+        pmr::Vector<std::pmr::string> words(&arena);
+        words.push_back("a string long enough to exceed small buffer optimization");
+        words.emplace_back(100, 'x');
+
+        CHECK(words[0].get_allocator().resource() == &arena);
+        CHECK(words[1].get_allocator().resource() == &arena);
+
+        pmr::Vector<std::pmr::string> filled(2, std::pmr::string{"text"}, &arena);
+        CHECK(filled[1].get_allocator().resource() == &arena);
+    }
+
+    SECTION("copy assignment - resource of target is kept")
+    {
+        pmr::Vector<int> source = {1, 2, 3};
+        pmr::Vector<int> target(&arena);
+
+        target = source;
+
+        CHECK(target == source);
+        CHECK(target.get_allocator().resource() == &arena);
+    }
+
+    SECTION("move assignment - items are moved one by one when resources differ")
+    {
+        pmr::Vector<std::pmr::string> source({"one", "two", "three"});
+        pmr::Vector<std::pmr::string> target(&arena);
+
+        target = std::move(source);
+
+        CHECK(target == pmr::Vector<std::pmr::string>{"one", "two", "three"});
+        CHECK(target.get_allocator().resource() == &arena);
+        CHECK(target[0].get_allocator().resource() == &arena);
+        CHECK(source.empty());
+    }
+
+    SECTION("move construction with equal allocator steals buffer")
+    {
+        pmr::Vector<int> source({1, 2, 3}, &arena);
+        const int* items = source.data();
+
+        pmr::Vector<int> target(std::move(source), &arena);
+
+        CHECK(target.data() == items);
+        CHECK(source.data() == nullptr);
+    }
+
+    SECTION("swap with the same resource")
+    {
+        pmr::Vector<int> vec1({1, 2}, &arena);
+        pmr::Vector<int> vec2({3, 4, 5}, &arena);
+
+        vec1.swap(vec2);
+
+        CHECK(vec1 == pmr::Vector<int>{3, 4, 5});
+        CHECK(vec2 == pmr::Vector<int>{1, 2});
+    }
+
+    SECTION("SmallVector - heap storage from given resource")
+    {
+        SmallVector<int, 2, std::pmr::polymorphic_allocator<int>> vec({1, 2, 3}, &arena);
+        SmallVector<int, 2, std::pmr::polymorphic_allocator<int>> target;
+
+        target = std::move(vec); // resources differ - items are relocated
+
+        CHECK(target == SmallVector<int, 2, std::pmr::polymorphic_allocator<int>>{1, 2, 3});
+        CHECK(target.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+}
+
 TEST_CASE("init with {}")
 {
     int x1;
@@ -346,19 +892,22 @@ struct X
     }
 };
 
-struct Data
+namespace // Data is also defined in move_semantics_3.cpp - internal linkage avoids ODR violation
 {
-    std::string name;
-    Vector<int> data;
+    struct Data
+    {
+        std::string name;
+        Vector<int> data;
 
-    /* implementation */
-};
+        /* implementation */
+    };
 
-Data create_dataset(std::string name, size_t size)
-{
-    Data ds{std::move(name), Vector(size)};
-    return ds;
-}
+    Data create_dataset(std::string name, size_t size)
+    {
+        Data ds{std::move(name), Vector(size)};
+        return ds;
+    }
+} // namespace
 
 TEST_CASE("support for copy/move semantics")
 {
@@ -0,0 +1,749 @@
+#ifndef VECTORLIKE_HPP
+#define VECTORLIKE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "relocatable.hpp"
+#include "simd_kernels.hpp"
+
+////////////////////////////////////////////////////////////////////////////
+// Growth policies - compute new capacity when Vector runs out of space
+
+template <size_t Numerator = 2, size_t Denominator = 1>
+struct GeometricGrowth
+{
+    static_assert(Denominator > 0 && Numerator > Denominator, "growth factor must be greater than 1");
+
+    static constexpr size_t next_capacity(size_t current_capacity, size_t required_capacity) noexcept
+    {
+        return std::max(current_capacity * Numerator / Denominator, required_capacity);
+    }
+};
+
+using DefaultGrowth = GeometricGrowth<2, 1>;
+
+////////////////////////////////////////////////////////////////////////////
+// Tracing policies - hooks called on copy & move of a Vector
+
+// zero-cost default - all hooks are empty
+struct NoTracing
+{
+    template <typename Container>
+    static void copy_constructed(const Container&) noexcept
+    { }
+
+    template <typename Container>
+    static void move_constructed(const Container&) noexcept
+    { }
+
+    template <typename Container>
+    static void copy_assigned(const Container&) noexcept
+    { }
+
+    template <typename Container>
+    static void move_assigned(const Container&) noexcept
+    { }
+};
+
+// logs every event with the content of a container to std::cout
+struct ConsoleTracing
+{
+    template <typename Container>
+    static void copy_constructed(const Container& vec)
+    {
+        std::cout << "Vector(cc: " << vec << ")\n";
+    }
+
+    template <typename Container>
+    static void move_constructed(const Container& vec)
+    {
+        std::cout << "Vector(mv: " << vec << ")\n";
+    }
+
+    template <typename Container>
+    static void copy_assigned(const Container& vec)
+    {
+        std::cout << "Vector(c=: " << vec << ")\n";
+    }
+
+    template <typename Container>
+    static void move_assigned(const Container& vec)
+    {
+        std::cout << "Vector(m=: " << vec << ")\n";
+    }
+};
+
+// counts events without any I/O - counters are shared by all containers using this policy
+struct CountingTracing
+{
+    inline static size_t copy_constructions{};
+    inline static size_t move_constructions{};
+    inline static size_t copy_assignments{};
+    inline static size_t move_assignments{};
+
+    static void reset() noexcept
+    {
+        copy_constructions = 0;
+        move_constructions = 0;
+        copy_assignments = 0;
+        move_assignments = 0;
+    }
+
+    template <typename Container>
+    static void copy_constructed(const Container&) noexcept
+    {
+        ++copy_constructions;
+    }
+
+    template <typename Container>
+    static void move_constructed(const Container&) noexcept
+    {
+        ++move_constructions;
+    }
+
+    template <typename Container>
+    static void copy_assigned(const Container&) noexcept
+    {
+        ++copy_assignments;
+    }
+
+    template <typename Container>
+    static void move_assigned(const Container&) noexcept
+    {
+        ++move_assignments;
+    }
+};
+
+#ifdef ENABLE_LOGGING_TO_CONSOLE
+using DefaultTracing = ConsoleTracing;
+#else
+using DefaultTracing = NoTracing;
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// tag for constructors that leave trivial items default-initialized (no zeroing)
+
+struct default_init_t
+{
+    explicit default_init_t() = default;
+};
+
+inline constexpr default_init_t default_init{};
+
+////////////////////////////////////////////////////////////////////////////
+// Vector - contiguous container with separate size & capacity
+
+template <typename T = int, typename Allocator = std::allocator<T>, typename GrowthPolicy = DefaultGrowth, typename TracingPolicy = DefaultTracing>
+class Vector
+{
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocatorTraits::value_type, T>, "Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename AllocatorTraits::pointer, T*>, "fancy pointers are not supported");
+
+    static constexpr bool propagate_on_copy = AllocatorTraits::propagate_on_container_copy_assignment::value;
+    static constexpr bool propagate_on_move = AllocatorTraits::propagate_on_container_move_assignment::value;
+    static constexpr bool propagate_on_swap = AllocatorTraits::propagate_on_container_swap::value;
+
+    // allocator-aware items (e.g. std::pmr::string) are constructed through the allocator of the container
+    static constexpr bool uses_allocator_construction = std::uses_allocator_v<T, Allocator>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    Vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+        : Vector(Allocator())
+    { }
+
+    explicit Vector(const std::type_identity_t<Allocator>& alloc) noexcept
+        : alloc_{alloc}
+        , items_{nullptr}
+        , size_{0}
+        , capacity_{0}
+    { }
+
+    // items are value-initialized - zeroed for arithmetic types
+    explicit Vector(size_t size, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : alloc_{alloc}
+        , items_{allocate(size)}
+        , size_{size}
+        , capacity_{size}
+    {
+        construct_or_deallocate([&] {
+            if constexpr (uses_allocator_construction)
+                construct_each();
+            else
+                std::uninitialized_value_construct_n(items_, size_);
+        });
+    }
+
+    // items are default-initialized - memory of trivial types is not touched
+    Vector(size_t size, default_init_t, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : alloc_{alloc}
+        , items_{allocate(size)}
+        , size_{size}
+        , capacity_{size}
+    {
+        construct_or_deallocate([&] {
+            if constexpr (uses_allocator_construction)
+                construct_each();
+            else
+                std::uninitialized_default_construct_n(items_, size_);
+        });
+    }
+
+    Vector(size_t size, const T& value, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : alloc_{alloc}
+        , items_{allocate(size)}
+        , size_{size}
+        , capacity_{size}
+    {
+        construct_or_deallocate([&] {
+            if constexpr (Simd::Vectorizable<T>)
+                Simd::fill(items_, size_, value);
+            else if constexpr (uses_allocator_construction)
+                construct_each(value);
+            else
+                std::uninitialized_fill_n(items_, size_, value);
+        });
+    }
+
+    Vector(std::initializer_list<T> il, const std::type_identity_t<Allocator>& alloc = Allocator())
+        : alloc_{alloc}
+        , items_{allocate(il.size())}
+        , size_{il.size()}
+        , capacity_{il.size()}
+    {
+        construct_or_deallocate([&] { copy_construct_items(il.begin()); });
+    }
+
+    /* copy semantics */
+    Vector(const Vector& vec)
+        : Vector(vec, AllocatorTraits::select_on_container_copy_construction(vec.alloc_))
+    { }
+
+    Vector(const Vector& vec, const std::type_identity_t<Allocator>& alloc)
+        : alloc_{alloc}
+        , items_{allocate(vec.size())}
+        , size_{vec.size()}
+        , capacity_{vec.size()}
+    {
+        construct_or_deallocate([&] { copy_construct_items(vec.begin()); });
+        TracingPolicy::copy_constructed(*this);
+    }
+
+    Vector& operator=(const Vector& vec)
+    {
+        Vector temp(vec, propagate_on_copy ? vec.alloc_ : alloc_); // cc
+        swap_storage(temp);
+        if constexpr (propagate_on_copy)
+            std::swap(alloc_, temp.alloc_);
+
+        TracingPolicy::copy_assigned(*this);
+
+        return *this;
+    }
+
+    /* move semantics */
+    Vector(Vector&& vec) noexcept
+        : alloc_{std::move(vec.alloc_)}
+        , items_{std::exchange(vec.items_, nullptr)}
+        , size_{std::exchange(vec.size_, 0)}
+        , capacity_{std::exchange(vec.capacity_, 0)}
+    {
+        TracingPolicy::move_constructed(*this);
+    }
+
+    // buffer is stolen only when memory can be released by alloc - otherwise items are moved one by one
+    Vector(Vector&& vec, const std::type_identity_t<Allocator>& alloc)
+        : alloc_{alloc}
+        , items_{nullptr}
+        , size_{0}
+        , capacity_{0}
+    {
+        if (AllocatorTraits::is_always_equal::value || alloc_ == vec.alloc_)
+        {
+            swap_storage(vec);
+        }
+        else
+        {
+            items_ = allocate(vec.size_);
+            size_ = vec.size_;
+            capacity_ = vec.size_;
+            construct_or_deallocate([&] { move_construct_items(vec.begin()); });
+            vec.clear();
+        }
+
+        TracingPolicy::move_constructed(*this);
+    }
+
+    Vector& operator=(Vector&& vec) noexcept(propagate_on_move || AllocatorTraits::is_always_equal::value)
+    {
+        if (this != &vec)
+        {
+            if constexpr (propagate_on_move)
+            {
+                Vector temp{std::move(vec)}; // mv
+                swap_storage(temp);
+                std::swap(alloc_, temp.alloc_);
+            }
+            else
+            {
+                Vector temp(std::move(vec), alloc_); // mv - items are moved if allocators are not equal
+                swap_storage(temp);
+            }
+
+            TracingPolicy::move_assigned(*this);
+        }
+
+        return *this;
+    }
+
+    // allocators are swapped only if they propagate on swap - otherwise they must be equal
+    void swap(Vector& vec) noexcept
+    {
+        if constexpr (propagate_on_swap)
+            std::swap(alloc_, vec.alloc_);
+        else
+            assert(alloc_ == vec.alloc_);
+
+        swap_storage(vec);
+    }
+
+    ~Vector() noexcept
+    {
+        std::destroy_n(items_, size_);
+        deallocate(items_, capacity_);
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    T* data() const noexcept
+    {
+        return items_;
+    }
+
+    reference operator[](size_t index)
+    {
+        return items_[index]; // *(items_ + index)
+    }
+
+    const_reference operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    reference back()
+    {
+        return items_[size_ - 1];
+    }
+
+    const_reference back() const
+    {
+        return items_[size_ - 1];
+    }
+
+    /* capacity management */
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+            reallocate(new_capacity);
+    }
+
+    void shrink_to_fit()
+    {
+        if (capacity_ > size_)
+            reallocate(size_);
+    }
+
+    /* modifiers */
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    template <typename... TArgs>
+    reference emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+            return emplace_back_with_reallocation(std::forward<TArgs>(args)...);
+
+        T* item = construct_item(items_ + size_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    template <typename... TArgs>
+    iterator emplace(const_iterator pos, TArgs&&... args)
+    {
+        const size_t index = pos - begin();
+
+        if (index == size_)
+        {
+            emplace_back(std::forward<TArgs>(args)...);
+            return items_ + index;
+        }
+
+        // new item is constructed first - args may refer to an element of this vector
+        T item = make_item(std::forward<TArgs>(args)...);
+
+        if (size_ == capacity_)
+            reallocate(GrowthPolicy::next_capacity(capacity_, size_ + 1));
+
+        T* gap = items_ + index;
+
+        if constexpr (Helpers::is_trivially_relocatable_v<T>)
+        {
+            Helpers::relocate_overlapping_n(gap, size_ - index, gap + 1);
+
+            try
+            {
+                construct_item(gap, std::move(item));
+            }
+            catch (...)
+            {
+                Helpers::relocate_overlapping_n(gap + 1, size_ - index, gap);
+                throw;
+            }
+
+            ++size_;
+        }
+        else
+        {
+            construct_item(items_ + size_, std::move(items_[size_ - 1]));
+            ++size_;
+
+            std::move_backward(gap, items_ + size_ - 2, items_ + size_ - 1);
+            *gap = std::move(item);
+        }
+
+        return gap;
+    }
+
+    iterator insert(const_iterator pos, const T& item)
+    {
+        return emplace(pos, item);
+    }
+
+    iterator insert(const_iterator pos, T&& item)
+    {
+        return emplace(pos, std::move(item));
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        T* gap_first = items_ + (first - begin());
+        T* gap_last = items_ + (last - begin());
+
+        if constexpr (Helpers::is_trivially_relocatable_v<T>)
+        {
+            std::destroy(gap_first, gap_last);
+            Helpers::relocate_overlapping_n(gap_last, end() - gap_last, gap_first);
+        }
+        else
+        {
+            T* new_end = std::move(gap_last, end(), gap_first);
+            std::destroy(new_end, end());
+        }
+
+        size_ -= gap_last - gap_first;
+
+        return gap_first;
+    }
+
+    void pop_back() noexcept
+    {
+        std::destroy_at(items_ + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(items_, size_);
+        size_ = 0;
+    }
+
+    bool operator==(const Vector& rhs) const noexcept
+    {
+        if constexpr (Simd::Vectorizable<T>)
+            return size_ == rhs.size_ && Simd::equal(items_, rhs.items_, size_);
+        else
+            return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    bool operator!=(const Vector& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    /* reductions - vectorized for arithmetic types */
+    Simd::sum_type_t<T> sum() const noexcept
+        requires Simd::Reducible<T>
+    {
+        return Simd::sum(items_, size_);
+    }
+
+    T min() const noexcept
+        requires Simd::Reducible<T>
+    {
+        assert(!empty());
+        return Simd::min(items_, size_);
+    }
+
+    T max() const noexcept
+        requires Simd::Reducible<T>
+    {
+        assert(!empty());
+        return Simd::max(items_, size_);
+    }
+
+    iterator begin() noexcept
+    {
+        return items_;
+    }
+
+    iterator end() noexcept
+    {
+        return items_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return items_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items_ + size_;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const Vector& vec)
+    {
+        out << "{ ";
+        for (const auto& item : vec)
+        {
+            out << item << " ";
+        }
+        out << "}";
+
+        return out;
+    }
+
+private:
+    [[no_unique_address]] Allocator alloc_;
+    T* items_ = nullptr;
+    size_t size_{};
+    size_t capacity_{};
+
+    T* allocate(size_t capacity)
+    {
+        if (capacity == 0)
+            return nullptr;
+
+        return AllocatorTraits::allocate(alloc_, capacity);
+    }
+
+    void deallocate(T* items, size_t capacity) noexcept
+    {
+        if (items)
+            AllocatorTraits::deallocate(alloc_, items, capacity);
+    }
+
+    void swap_storage(Vector& vec) noexcept
+    {
+        std::swap(items_, vec.items_);
+        std::swap(size_, vec.size_);
+        std::swap(capacity_, vec.capacity_);
+    }
+
+    template <typename... TArgs>
+    T* construct_item(T* place, TArgs&&... args)
+    {
+        AllocatorTraits::construct(alloc_, place, std::forward<TArgs>(args)...);
+        return place;
+    }
+
+    template <typename... TArgs>
+    T make_item(TArgs&&... args)
+    {
+        if constexpr (uses_allocator_construction)
+            return std::make_obj_using_allocator<T>(alloc_, std::forward<TArgs>(args)...);
+        else
+            return T(std::forward<TArgs>(args)...);
+    }
+
+    // constructs items_[0, size_) from the same args through the allocator
+    template <typename... TArgs>
+    void construct_each(const TArgs&... args)
+    {
+        size_t i = 0;
+        try
+        {
+            for (; i < size_; ++i)
+                construct_item(items_ + i, args...);
+        }
+        catch (...)
+        {
+            std::destroy_n(items_, i);
+            throw;
+        }
+    }
+
+    template <typename InputIterator>
+    void copy_construct_items(InputIterator first)
+    {
+        if constexpr (uses_allocator_construction)
+        {
+            size_t i = 0;
+            try
+            {
+                for (; i < size_; ++i, ++first)
+                    construct_item(items_ + i, *first);
+            }
+            catch (...)
+            {
+                std::destroy_n(items_, i);
+                throw;
+            }
+        }
+        else
+        {
+            std::uninitialized_copy_n(first, size_, items_);
+        }
+    }
+
+    void move_construct_items(T* first)
+    {
+        copy_construct_items(std::make_move_iterator(first));
+    }
+
+    template <typename Constructor>
+    void construct_or_deallocate(Constructor construct)
+    {
+        try
+        {
+            construct();
+        }
+        catch (...)
+        {
+            deallocate(items_, capacity_);
+            throw;
+        }
+    }
+
+    void reallocate(size_t new_capacity)
+    {
+        T* new_items = allocate(new_capacity);
+
+        try
+        {
+            Helpers::uninitialized_relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        replace_storage(new_items, new_capacity);
+    }
+
+    template <typename... TArgs>
+    reference emplace_back_with_reallocation(TArgs&&... args)
+    {
+        const size_t new_capacity = GrowthPolicy::next_capacity(capacity_, size_ + 1);
+        T* new_items = allocate(new_capacity);
+
+        // new item is constructed first - args may refer to an element of this vector
+        T* item = nullptr;
+        try
+        {
+            item = construct_item(new_items + size_, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        try
+        {
+            Helpers::uninitialized_relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            std::destroy_at(item);
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        replace_storage(new_items, new_capacity);
+        ++size_;
+
+        return *item;
+    }
+
+    // items_ must already be relocated to new_items
+    void replace_storage(T* new_items, size_t new_capacity) noexcept
+    {
+        deallocate(items_, capacity_);
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+    }
+};
+
+namespace pmr
+{
+    template <typename T, typename GrowthPolicy = DefaultGrowth, typename TracingPolicy = DefaultTracing>
+    using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy, TracingPolicy>;
+}
+
+// Vector holds only pointers - it is trivially relocatable when its allocator is
+template <typename T, typename Allocator, typename GrowthPolicy, typename TracingPolicy>
+struct Helpers::is_trivially_relocatable<Vector<T, Allocator, GrowthPolicy, TracingPolicy>> : Helpers::is_trivially_relocatable<Allocator>
+{
+};
+
+#endif /*VECTORLIKE_HPP*/
@@ -0,0 +1,238 @@
+#include "intrusive_ptr.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Helpers::intrusive_ptr;
+using Helpers::intrusive_weak_ptr;
+using Helpers::make_intrusive;
+
+namespace
+{
+    template <typename CountingPolicy = Helpers::AtomicCounting>
+    class Document : public Helpers::RefCounted<Document<CountingPolicy>, CountingPolicy>
+    {
+        std::string title_;
+        int* destroyed_;
+
+    public:
+        explicit Document(std::string title, int* destroyed = nullptr)
+            : title_{std::move(title)}
+            , destroyed_{destroyed}
+        {
+        }
+
+        ~Document()
+        {
+            if (destroyed_)
+                ++*destroyed_;
+        }
+
+        const std::string& title() const
+        {
+            return title_;
+        }
+    };
+
+    struct Counter
+    {
+        int value = 0;
+    };
+
+    struct SharedCounter : Counter
+    {
+    };
+
+    struct IntrusiveCounter : Counter, Helpers::RefCounted<IntrusiveCounter>
+    {
+    };
+
+    struct LocalIntrusiveCounter : Counter, Helpers::RefCounted<LocalIntrusiveCounter, Helpers::NonAtomicCounting>
+    {
+    };
+} // namespace
+
+TEST_CASE("intrusive_ptr")
+{
+    int destroyed = 0;
+
+    SECTION("count is kept in the object")
+    {
+        auto ptr1 = make_intrusive<Document<>>("ipad", &destroyed);
+        REQUIRE(ptr1->use_count() == 1);
+
+        {
+            auto ptr2 = ptr1;
+            REQUIRE(ptr1->use_count() == 2);
+            REQUIRE(ptr2 == ptr1);
+        }
+
+        REQUIRE(ptr1->use_count() == 1);
+
+        ptr1.reset();
+        REQUIRE(ptr1 == nullptr);
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("raw pointer may be wrapped again - no second control block")
+    {
+        auto ptr1 = make_intrusive<Document<>>("ipad", &destroyed);
+        Document<>* raw = ptr1.get();
+
+        intrusive_ptr<Document<>> ptr2{raw};
+        REQUIRE(raw->use_count() == 2);
+
+        ptr1.reset();
+        ptr2.reset();
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("detach & adopt")
+    {
+        auto ptr1 = make_intrusive<Document<>>("ipad", &destroyed);
+        Document<>* raw = ptr1.detach();
+        REQUIRE(raw->use_count() == 1);
+
+        intrusive_ptr<Document<>> ptr2{raw, false};
+        REQUIRE(raw->use_count() == 1);
+    }
+
+    SECTION("non-atomic counting")
+    {
+        auto ptr = make_intrusive<Document<Helpers::NonAtomicCounting>>("ipad", &destroyed);
+        auto other = std::move(ptr);
+
+        REQUIRE(ptr == nullptr);
+        REQUIRE(other->use_count() == 1);
+    }
+
+    REQUIRE(destroyed == 1);
+}
+
+TEST_CASE("intrusive_weak_ptr")
+{
+    int destroyed = 0;
+
+    SECTION("lock returns object while it is alive")
+    {
+        auto ptr = make_intrusive<Document<>>("ipad", &destroyed);
+        intrusive_weak_ptr<Document<>> weak = ptr;
+
+        REQUIRE_FALSE(weak.expired());
+        REQUIRE(weak.lock()->title() == "ipad");
+        REQUIRE(ptr->use_count() == 1);
+
+        ptr.reset();
+
+        REQUIRE(destroyed == 1);
+        REQUIRE(weak.expired());
+        REQUIRE(weak.lock() == nullptr);
+    }
+
+    SECTION("weak_ptr does not keep object alive - circular references")
+    {
+        using Doc = Document<Helpers::NonAtomicCounting>;
+
+        auto ptr = make_intrusive<Doc>("ipad", &destroyed);
+        intrusive_weak_ptr<Doc> weak1 = ptr;
+        auto weak2 = weak1;
+
+        ptr.reset();
+
+        REQUIRE(destroyed == 1);
+        REQUIRE(weak2.lock() == nullptr);
+    }
+
+    SECTION("concurrent lock & release")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            auto ptr = make_intrusive<Document<>>("ipad", &destroyed);
+            intrusive_weak_ptr<Document<>> weak = ptr;
+
+            bool title_matches = true;
+
+            std::thread locker{[weak, &title_matches] {
+                while (auto locked = weak.lock())
+                    title_matches = title_matches && locked->title() == "ipad";
+            }};
+
+            ptr.reset();
+            locker.join();
+
+            REQUIRE(title_matches);
+        }
+
+        REQUIRE(destroyed == 100);
+    }
+}
+
+TEST_CASE("intrusive_ptr vs. shared_ptr - benchmark", "[.][benchmark]")
+{
+    constexpr int count = 1'000;
+
+    auto shared = std::make_shared<SharedCounter>();
+    auto intrusive = make_intrusive<IntrusiveCounter>();
+    auto local_intrusive = make_intrusive<LocalIntrusiveCounter>();
+
+    BENCHMARK("copy - shared_ptr")
+    {
+        std::vector<std::shared_ptr<SharedCounter>> copies(count, shared);
+        return copies.size();
+    };
+
+    BENCHMARK("copy - intrusive_ptr<atomic>")
+    {
+        std::vector<intrusive_ptr<IntrusiveCounter>> copies(count, intrusive);
+        return copies.size();
+    };
+
+    BENCHMARK("copy - intrusive_ptr<non-atomic>")
+    {
+        std::vector<intrusive_ptr<LocalIntrusiveCounter>> copies(count, local_intrusive);
+        return copies.size();
+    };
+
+    BENCHMARK("create & destroy - shared_ptr(new T)")
+    {
+        return std::shared_ptr<SharedCounter>(new SharedCounter{})->value;
+    };
+
+    BENCHMARK("create & destroy - make_shared")
+    {
+        return std::make_shared<SharedCounter>()->value;
+    };
+
+    BENCHMARK("create & destroy - make_intrusive<atomic>")
+    {
+        return make_intrusive<IntrusiveCounter>()->value;
+    };
+
+    BENCHMARK("create & destroy - make_intrusive<non-atomic>")
+    {
+        return make_intrusive<LocalIntrusiveCounter>()->value;
+    };
+
+    std::weak_ptr<SharedCounter> weak_shared = shared;
+    intrusive_weak_ptr<IntrusiveCounter> weak_intrusive = intrusive;
+    intrusive_weak_ptr<LocalIntrusiveCounter> weak_local_intrusive = local_intrusive;
+
+    BENCHMARK("lock - weak_ptr")
+    {
+        return weak_shared.lock()->value;
+    };
+
+    BENCHMARK("lock - intrusive_weak_ptr<atomic>")
+    {
+        return weak_intrusive.lock()->value;
+    };
+
+    BENCHMARK("lock - intrusive_weak_ptr<non-atomic>")
+    {
+        return weak_local_intrusive.lock()->value;
+    };
+}
@@ -0,0 +1,210 @@
+#include "local_shared_ptr.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Helpers::local_shared_ptr;
+using Helpers::local_weak_ptr;
+using Helpers::make_local_shared;
+
+namespace
+{
+    class Person
+    {
+        std::string name_;
+        local_weak_ptr<Person> partner_;
+        int* destroyed_;
+
+    public:
+        explicit Person(std::string name, int* destroyed)
+            : name_{std::move(name)}
+            , destroyed_{destroyed}
+        {
+        }
+
+        ~Person()
+        {
+            ++*destroyed_;
+        }
+
+        const std::string& name() const
+        {
+            return name_;
+        }
+
+        void set_partner(local_weak_ptr<Person> partner)
+        {
+            partner_ = std::move(partner);
+        }
+
+        local_shared_ptr<Person> partner() const
+        {
+            return partner_.lock();
+        }
+    };
+
+    struct Base
+    {
+        int value = 42;
+        virtual ~Base() = default;
+    };
+
+    struct Derived : Base
+    {
+    };
+} // namespace
+
+TEST_CASE("local_shared_ptr")
+{
+    int destroyed = 0;
+
+    SECTION("make_local_shared")
+    {
+        auto ptr1 = make_local_shared<Person>("Jan", &destroyed);
+        REQUIRE(ptr1.use_count() == 1);
+
+        auto ptr2 = ptr1;
+        REQUIRE(ptr1.use_count() == 2);
+        REQUIRE(ptr1 == ptr2);
+
+        ptr1.reset();
+        REQUIRE(ptr1 == nullptr);
+        REQUIRE(ptr2.use_count() == 1);
+        REQUIRE(ptr2->name() == "Jan");
+
+        ptr2.reset();
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("raw pointer & custom deleter")
+    {
+        bool deleter_called = false;
+        auto deleter = [&deleter_called](Person* p) {
+            deleter_called = true;
+            delete p;
+        };
+
+        local_shared_ptr<Person> ptr{new Person("Ewa", &destroyed), deleter};
+        ptr.reset();
+
+        REQUIRE(deleter_called);
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("from unique_ptr")
+    {
+        local_shared_ptr<Person> ptr = std::make_unique<Person>("Ewa", &destroyed);
+        REQUIRE(ptr.use_count() == 1);
+
+        ptr.reset();
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("from unique_ptr with deleter held by reference")
+    {
+        int deleter_calls = 0;
+        auto deleter = [&deleter_calls](Person* p) { ++deleter_calls; delete p; };
+
+        std::unique_ptr<Person, decltype(deleter)&> uptr{new Person("Ewa", &destroyed), deleter};
+        local_shared_ptr<Person> ptr = std::move(uptr);
+        REQUIRE(uptr == nullptr);
+
+        ptr.reset();
+        REQUIRE(deleter_calls == 1);
+        REQUIRE(destroyed == 1);
+    }
+
+    SECTION("conversion & aliasing")
+    {
+        local_shared_ptr<Base> base = make_local_shared<Derived>();
+        local_shared_ptr<int> value{base, &base->value};
+
+        base.reset();
+
+        REQUIRE(*value == 42);
+        REQUIRE(value.use_count() == 1);
+    }
+}
+
+TEST_CASE("local_weak_ptr")
+{
+    int destroyed = 0;
+
+    SECTION("lock & expired")
+    {
+        auto ptr = make_local_shared<Person>("Jan", &destroyed);
+        local_weak_ptr<Person> weak = ptr;
+
+        REQUIRE(weak.use_count() == 1);
+        REQUIRE(weak.lock()->name() == "Jan");
+
+        ptr.reset();
+
+        REQUIRE(destroyed == 1);
+        REQUIRE(weak.expired());
+        REQUIRE(weak.lock() == nullptr);
+        REQUIRE_THROWS_AS(local_shared_ptr<Person>{weak}, std::bad_weak_ptr);
+    }
+
+    SECTION("partners do not leak")
+    {
+        auto husband = make_local_shared<Person>("Jan", &destroyed);
+        auto wife = make_local_shared<Person>("Ewa", &destroyed);
+
+        husband->set_partner(wife);
+        wife->set_partner(husband);
+
+        REQUIRE(husband->partner()->name() == "Ewa");
+
+        husband.reset();
+        wife.reset();
+
+        REQUIRE(destroyed == 2);
+    }
+}
+
+TEST_CASE("local_shared_ptr vs. shared_ptr - benchmark", "[.][benchmark]")
+{
+    constexpr int count = 1'000;
+
+    auto shared = std::make_shared<Base>();
+    auto local = make_local_shared<Base>();
+
+    BENCHMARK("copy - shared_ptr")
+    {
+        std::vector<std::shared_ptr<Base>> copies(count, shared);
+        return copies.size();
+    };
+
+    BENCHMARK("copy - local_shared_ptr")
+    {
+        std::vector<local_shared_ptr<Base>> copies(count, local);
+        return copies.size();
+    };
+
+    BENCHMARK("create & destroy - make_shared")
+    {
+        return std::make_shared<Base>()->value;
+    };
+
+    BENCHMARK("create & destroy - make_local_shared")
+    {
+        return make_local_shared<Base>()->value;
+    };
+
+    std::weak_ptr<Base> weak_shared = shared;
+    local_weak_ptr<Base> weak_local = local;
+
+    BENCHMARK("lock - weak_ptr")
+    {
+        return weak_shared.lock()->value;
+    };
+
+    BENCHMARK("lock - local_weak_ptr")
+    {
+        return weak_local.lock()->value;
+    };
+}
@@ -114,6 +114,15 @@ namespace LegacyCode
     {
         delete[] b;
     }
+
+    // stateless deleter - unique_ptr stays as small as a raw pointer
+    struct BufferDeleter
+    {
+        void operator()(int* b) const noexcept
+        {
+            free_buffer(b);
+        }
+    };
 } // namespace LegacyCode
 
 TEST_CASE("dynamic memory management in modern C+")
@@ -182,9 +191,12 @@ TEST_CASE("dynamic memory management in modern C+")
         {
             bool early_exit = true;
 
-            std::unique_ptr<int[], void(*)(int*)> buffer(LegacyCode::create_buffer(), &LegacyCode::free_buffer);
+            std::unique_ptr<int[], LegacyCode::BufferDeleter> buffer(LegacyCode::create_buffer());
             buffer[56] = 543;
 
+            static_assert(sizeof(buffer) == sizeof(int*));
+            static_assert(sizeof(std::unique_ptr<int[], void (*)(int*)>) == 2 * sizeof(int*)); // function pointer is stored
+
             if (early_exit)
                 return;
         }
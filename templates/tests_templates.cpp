@@ -3,13 +3,20 @@
 #endif
 
 #include "helpers.hpp"
+#include "simd_kernels.hpp"
 
 #include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -50,9 +57,21 @@ namespace Auto
 
 namespace Exercise
 {
+    // contiguous range of arithmetic items searched for a value of the same type - compared with SIMD
+    template <typename Iter, typename Value>
+    constexpr bool is_simd_searchable_v = std::contiguous_iterator<Iter>
+        && Simd::Vectorizable<std::iter_value_t<Iter>>
+        && std::is_same_v<Value, std::iter_value_t<Iter>>;
+
     template <typename Iter, typename Value>
     Iter find(Iter begin, Iter end, const Value& value)
     {
+        if constexpr (is_simd_searchable_v<Iter, Value>)
+        {
+            const size_t count = end - begin;
+            return begin + Simd::find(std::to_address(begin), count, value);
+        }
+
         for (auto it = begin; it != end; ++it)
         {
             if (*it == value)
@@ -66,7 +85,9 @@ namespace Exercise
     template <typename Iter, typename Predicate>
     Iter find_if(Iter begin, Iter end, Predicate predicate)
     {
+#ifdef TRACE_TEMPLATE_INSTANTIATIONS
         std::cout << __PRETTY_FUNCTION__ << "\n";
+#endif
 
         for (auto it = begin; it != end; ++it)
         {
@@ -119,6 +140,81 @@ TEMPLATE_TEST_CASE("find", "[algo]", (std::vector<int>), (std::list<int>))
     }
 }
 
+namespace
+{
+    template <typename T>
+    std::vector<T> random_items(size_t count, std::mt19937_64& rnd)
+    {
+        std::vector<T> items(count);
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            std::uniform_real_distribution<T> distribution{T(-100), T(100)};
+            std::generate(items.begin(), items.end(), [&] { return distribution(rnd); });
+        }
+        else
+        {
+            std::uniform_int_distribution<long long> distribution{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+            std::generate(items.begin(), items.end(), [&] { return static_cast<T>(distribution(rnd)); });
+        }
+
+        return items;
+    }
+} // namespace
+
+TEMPLATE_TEST_CASE("find - large random ranges", "[algo]", std::int8_t, std::uint16_t, int, std::int64_t, float, double)
+{
+    const unsigned seed = GENERATE(1u, 2u, 3u);
+    std::mt19937_64 rnd{seed};
+    const size_t size = std::uniform_int_distribution<size_t>{0, 100'000}(rnd);
+    const std::vector<TestType> items = random_items<TestType>(size, rnd);
+
+    SECTION("values from range")
+    {
+        std::uniform_int_distribution<size_t> index{0, size - 1};
+
+        for (int i = 0; i < 100 && size > 0; ++i)
+        {
+            const TestType value = items[index(rnd)];
+            REQUIRE(Exercise::find(items.begin(), items.end(), value) == std::find(items.begin(), items.end(), value));
+        }
+    }
+
+    SECTION("random values - found or not")
+    {
+        for (const TestType value : random_items<TestType>(100, rnd))
+            REQUIRE(Exercise::find(items.begin(), items.end(), value) == std::find(items.begin(), items.end(), value));
+    }
+
+    SECTION("subranges - unaligned begin & tails")
+    {
+        const std::vector<TestType> all_equal(77, TestType(1));
+
+        for (size_t offset = 0; offset < all_equal.size(); ++offset)
+        {
+            REQUIRE(Exercise::find(all_equal.begin() + offset, all_equal.end(), TestType(1)) == all_equal.begin() + offset);
+            REQUIRE(Exercise::find(all_equal.begin() + offset, all_equal.end(), TestType(2)) == all_equal.end());
+        }
+    }
+}
+
+TEST_CASE("find - benchmark", "[.][benchmark]")
+{
+    std::vector<int> items(1'000'000);
+    std::iota(items.begin(), items.end(), 0);
+    const int last = items.back();
+
+    BENCHMARK("std::find")
+    {
+        return std::find(items.begin(), items.end(), last);
+    };
+
+    BENCHMARK("Exercise::find")
+    {
+        return Exercise::find(items.begin(), items.end(), last);
+    };
+}
+
 bool is_even(int x)
 {
     return x % 2 == 0;